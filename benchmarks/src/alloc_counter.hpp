@@ -0,0 +1,14 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace ssts::bench
+{
+
+/*! Number of calls to the global operator new since program start.
+ *  The replacement allocation functions are defined in main.cpp.
+ */
+std::size_t allocations();
+
+}
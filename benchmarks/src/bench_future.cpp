@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+#include <ssts/future.hpp>
+#include <future>
+
+#include "alloc_counter.hpp"
+
+template<template<typename> class Promise>
+static void BM_Future_SetGet(benchmark::State& state)
+{
+    const auto allocations_before = ssts::bench::allocations();
+
+    for (auto _ : state)
+    {
+        Promise<int> p;
+        auto f = p.get_future();
+        p.set_value(42);
+        benchmark::DoNotOptimize(f.get());
+    }
+
+    state.counters["allocs_per_future"] = benchmark::Counter(
+        static_cast<double>(ssts::bench::allocations() - allocations_before),
+        benchmark::Counter::kAvgIterations);
+}
+
+static void BM_Future_Then(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        ssts::promise<int> p;
+        auto f = p.get_future().then([](int v) { return v + 1; });
+        p.set_value(41);
+        benchmark::DoNotOptimize(f.get());
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_Future_SetGet, std::promise);
+BENCHMARK_TEMPLATE(BM_Future_SetGet, ssts::promise);
+BENCHMARK(BM_Future_Then);
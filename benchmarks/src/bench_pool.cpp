@@ -0,0 +1,232 @@
+#include <benchmark/benchmark.h>
+#include <ssts/task_pool.hpp>
+#include <atomic>
+#include <thread>
+
+namespace
+{
+
+constexpr std::size_t tasks_per_iteration = 1'000;
+
+void wait_for_runs(const std::atomic<std::size_t>& runs, std::size_t target)
+{
+    while (runs.load(std::memory_order_acquire) < target)
+        std::this_thread::yield();
+}
+
+}
+
+static void BM_Pool_Run(benchmark::State& state)
+{
+    ssts::task_pool tp(static_cast<unsigned>(state.range(0)));
+    std::atomic<std::size_t> runs{ 0 };
+
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + tasks_per_iteration;
+        for (std::size_t n = 0; n < tasks_per_iteration; ++n)
+            tp.run([&runs] { runs.fetch_add(1, std::memory_order_release); });
+
+        wait_for_runs(runs, target);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * tasks_per_iteration));
+}
+
+static void BM_Pool_Post(benchmark::State& state)
+{
+    ssts::task_pool tp(static_cast<unsigned>(state.range(0)));
+    std::atomic<std::size_t> runs{ 0 };
+
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + tasks_per_iteration;
+        for (std::size_t n = 0; n < tasks_per_iteration; ++n)
+            tp.post([&runs] { runs.fetch_add(1, std::memory_order_release); });
+
+        wait_for_runs(runs, target);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * tasks_per_iteration));
+}
+
+BENCHMARK(BM_Pool_Run)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK(BM_Pool_Post)->Arg(1)->Arg(4)->UseRealTime();
+
+namespace
+{
+
+ssts::pool_options make_options(const benchmark::State& state)
+{
+    ssts::pool_options options;
+    options.num_threads = static_cast<unsigned>(state.range(0));
+    options.mode = static_cast<ssts::pool_mode>(state.range(1));
+    return options;
+}
+
+void set_mode_label(benchmark::State& state)
+{
+    state.SetLabel(static_cast<ssts::pool_mode>(state.range(1)) == ssts::pool_mode::work_stealing ? "work_stealing" : "shared_queue");
+}
+
+}
+
+// External producer posting small tasks, for both pool modes and 1 to 64 threads.
+static void BM_Pool_PostScaling(benchmark::State& state)
+{
+    ssts::task_pool tp(make_options(state));
+    std::atomic<std::size_t> runs{ 0 };
+
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + tasks_per_iteration;
+        for (std::size_t n = 0; n < tasks_per_iteration; ++n)
+            tp.post([&runs] { runs.fetch_add(1, std::memory_order_release); });
+
+        wait_for_runs(runs, target);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * tasks_per_iteration));
+    set_mode_label(state);
+}
+
+// Tasks posted from inside the pool (e.g. nested or recursive tasks): one root task per worker fans out its children.
+static void BM_Pool_NestedScaling(benchmark::State& state)
+{
+    ssts::task_pool tp(make_options(state));
+    std::atomic<std::size_t> runs{ 0 };
+    const auto roots = static_cast<std::size_t>(state.range(0));
+    const auto children_per_root = tasks_per_iteration / roots;
+
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + roots * children_per_root;
+        for (std::size_t r = 0; r < roots; ++r)
+        {
+            tp.post([&tp, &runs, children_per_root]
+            {
+                for (std::size_t n = 0; n < children_per_root; ++n)
+                    tp.post([&runs] { runs.fetch_add(1, std::memory_order_release); });
+            });
+        }
+
+        wait_for_runs(runs, target);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * roots * children_per_root));
+    set_mode_label(state);
+}
+
+BENCHMARK(BM_Pool_PostScaling)->ArgsProduct({ { 1, 2, 4, 8, 16, 32, 64 }, { 0, 1 } })->UseRealTime();
+BENCHMARK(BM_Pool_NestedScaling)->ArgsProduct({ { 1, 2, 4, 8, 16, 32, 64 }, { 0, 1 } })->UseRealTime();
+
+// I/O-like tasks that block for 5ms: a fixed pool is bound by its thread count, an elastic pool adds threads.
+static void BM_Pool_BlockingTasks(benchmark::State& state)
+{
+    constexpr std::size_t blocking_tasks = 32;
+    ssts::pool_options options;
+    options.num_threads = 2;
+    options.max_threads = static_cast<unsigned>(state.range(0));
+    options.max_queue_wait = std::chrono::milliseconds(1);
+
+    ssts::task_pool tp(options);
+    std::atomic<std::size_t> runs{ 0 };
+
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + blocking_tasks;
+        for (std::size_t n = 0; n < blocking_tasks; ++n)
+            tp.post([&runs] { std::this_thread::sleep_for(std::chrono::milliseconds(5)); runs.fetch_add(1, std::memory_order_release); });
+
+        wait_for_runs(runs, target);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blocking_tasks));
+    state.counters["threads"] = tp.thread_count();
+}
+
+BENCHMARK(BM_Pool_BlockingTasks)->Arg(2)->Arg(32)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Single task round trip from the calling thread to an idle worker, with workers that park at once (0)
+// or spin up to 100us before parking (1). The caller waits for each task before posting the next one,
+// so that every handoff finds the worker idle.
+static void BM_Pool_HandoffLatency(benchmark::State& state)
+{
+    ssts::pool_options options;
+    options.num_threads = 1;
+    if (state.range(0))
+        options.wait = ssts::wait_strategy::spin_then_park(std::chrono::microseconds(100));
+
+    ssts::task_pool tp(options);
+    std::atomic<std::size_t> runs{ 0 };
+
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + 1;
+        tp.post([&runs] { runs.fetch_add(1, std::memory_order_release); });
+        wait_for_runs(runs, target);
+    }
+}
+
+BENCHMARK(BM_Pool_HandoffLatency)->Arg(0)->Arg(1)->UseRealTime();
+
+// Cost of utilization counters: post throughput of a single worker with counters disabled (0) and enabled (1).
+static void BM_Pool_UtilizationOverhead(benchmark::State& state)
+{
+    ssts::pool_options options;
+    options.num_threads = 1;
+    options.utilization_stats = state.range(0) != 0;
+
+    ssts::task_pool tp(options);
+    std::atomic<std::size_t> runs{ 0 };
+
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + tasks_per_iteration;
+        for (std::size_t n = 0; n < tasks_per_iteration; ++n)
+            tp.post([&runs] { runs.fetch_add(1, std::memory_order_release); });
+
+        wait_for_runs(runs, target);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * tasks_per_iteration));
+    state.counters["utilization"] = tp.stats().utilization();
+}
+
+BENCHMARK(BM_Pool_UtilizationOverhead)->Arg(0)->Arg(1)->UseRealTime();
+
+// Drain of state.range(0) tasks queued with alternating normal and low priority behind a blocked single worker, in EDF order.
+// Each pop checks the oldest low priority task for starvation: items per second stay flat as the queue depth grows
+// when that check is O(1) and pops are O(log n). With state.range(1) set every low priority task is starved,
+// so that pops alternate between the earliest deadline and the oldest task.
+static void BM_Pool_EdfMixedPriorityDrain(benchmark::State& state)
+{
+    const auto queue_depth = static_cast<std::size_t>(state.range(0));
+
+    ssts::pool_options options;
+    options.num_threads = 1;
+    options.order = ssts::queue_order::earliest_deadline_first;
+    options.starvation_timeout = state.range(1) ? std::chrono::nanoseconds(0) : std::chrono::nanoseconds(std::chrono::hours(1));
+
+    ssts::task_pool tp(options);
+    std::atomic<std::size_t> runs{ 0 };
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::atomic_bool is_released{ false };
+        tp.post([&is_released] { while (!is_released.load(std::memory_order_acquire)) std::this_thread::yield(); });
+
+        const auto target = runs.load() + queue_depth;
+        for (std::size_t n = 0; n < queue_depth; ++n)
+            tp.post(n % 2 ? ssts::priority::low : ssts::priority::normal, [&runs] { runs.fetch_add(1, std::memory_order_release); });
+        state.ResumeTiming();
+
+        is_released.store(true, std::memory_order_release);
+        wait_for_runs(runs, target);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * queue_depth));
+}
+
+BENCHMARK(BM_Pool_EdfMixedPriorityDrain)->ArgsProduct({ { 1'000, 10'000, 100'000 }, { 0, 1 } })->UseRealTime();
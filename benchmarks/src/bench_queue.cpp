@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+#include <ssts/task_scheduler.hpp>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+using multimap_queue = ssts::multimap_queue<int>;
+using dary_heap_queue = ssts::dary_heap_queue<int>;
+using timing_wheel_queue = ssts::timing_wheel_queue<int>;
+
+std::vector<ssts::clock::duration> random_delays(std::size_t n)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int64_t> delay_ms(1, 60'000);
+
+    std::vector<ssts::clock::duration> delays;
+    for (std::size_t i = 0; i < n; ++i)
+        delays.emplace_back(std::chrono::milliseconds(delay_ms(rng)));
+
+    return delays;
+}
+
+}
+
+// Insert n timers with random delays up to one minute, then erase all of them (e.g. timeouts that never fire).
+template<typename Queue>
+static void BM_Queue_InsertErase(benchmark::State& state)
+{
+    const auto delays = random_delays(static_cast<std::size_t>(state.range(0)));
+    const auto now = ssts::clock::now();
+
+    Queue queue;
+    std::vector<typename Queue::handle> handles;
+    handles.reserve(delays.size());
+
+    for (auto _ : state)
+    {
+        for (const auto& d : delays)
+            handles.push_back(queue.insert(now + d, 0));
+
+        for (auto h : handles)
+            queue.erase(h);
+
+        handles.clear();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * delays.size()));
+}
+
+// Insert n timers with random delays up to one minute, then let time advance in 1ms steps until all of them expire.
+template<typename Queue>
+static void BM_Queue_InsertExpire(benchmark::State& state)
+{
+    const auto delays = random_delays(static_cast<std::size_t>(state.range(0)));
+
+    Queue queue;
+    std::vector<typename Queue::handle> due;
+
+    for (auto _ : state)
+    {
+        auto now = ssts::clock::now();
+        for (const auto& d : delays)
+            queue.insert(now + d, 0);
+
+        while (!queue.empty())
+        {
+            now += 1ms;
+            queue.collect_due(now, due);
+            for (auto h : due)
+                queue.erase(h);
+
+            due.clear();
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * delays.size()));
+}
+
+// Keep n timers queued and move a random one to a new random deadline (e.g. update_interval, timeouts being refreshed).
+template<typename Queue>
+static void BM_Queue_Reschedule(benchmark::State& state)
+{
+    const auto delays = random_delays(static_cast<std::size_t>(state.range(0)));
+    const auto now = ssts::clock::now();
+
+    Queue queue;
+    std::vector<typename Queue::handle> handles;
+    for (const auto& d : delays)
+        handles.push_back(queue.insert(now + d, 0));
+
+    std::size_t n = 0;
+    for (auto _ : state)
+    {
+        const auto i = (n * 7919) % handles.size();
+        handles[i] = queue.reschedule(handles[i], now + delays[n % delays.size()]);
+        ++n;
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+BENCHMARK_TEMPLATE(BM_Queue_InsertErase, multimap_queue)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(BM_Queue_InsertErase, dary_heap_queue)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(BM_Queue_InsertErase, timing_wheel_queue)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(BM_Queue_InsertExpire, multimap_queue)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(BM_Queue_InsertExpire, dary_heap_queue)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(BM_Queue_InsertExpire, timing_wheel_queue)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(BM_Queue_Reschedule, multimap_queue)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(BM_Queue_Reschedule, dary_heap_queue)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(BM_Queue_Reschedule, timing_wheel_queue)->Arg(1'000)->Arg(100'000);
@@ -0,0 +1,679 @@
+#include <benchmark/benchmark.h>
+#include <ssts/task_scheduler.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "alloc_counter.hpp"
+
+namespace
+{
+
+void wait_for_runs(const std::atomic<std::size_t>& runs, std::size_t target)
+{
+    while (runs.load(std::memory_order_acquire) < target)
+        std::this_thread::yield();
+}
+
+}
+
+static void BM_Scheduler_EveryFire(benchmark::State& state)
+{
+    ssts::task_scheduler s(1);
+    s.start();
+
+    std::atomic<std::size_t> runs{ 0 };
+    s.every(100us, [&runs] { runs.fetch_add(1, std::memory_order_release); });
+    wait_for_runs(runs, 10);
+
+    const auto allocations_before = ssts::bench::allocations();
+    const auto runs_before = runs.load();
+
+    for (auto _ : state)
+        wait_for_runs(runs, runs.load() + 1);
+
+    const auto fired = runs.load() - runs_before;
+    state.counters["allocs_per_fire"] = static_cast<double>(ssts::bench::allocations() - allocations_before) / static_cast<double>(fired);
+    s.stop();
+}
+
+static void BM_Scheduler_InFire(benchmark::State& state)
+{
+    ssts::task_scheduler s(1);
+    s.start();
+
+    std::atomic<std::size_t> runs{ 0 };
+    const auto allocations_before = ssts::bench::allocations();
+
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + 1;
+        s.in(0s, [&runs] { runs.fetch_add(1, std::memory_order_release); });
+        wait_for_runs(runs, target);
+    }
+
+    state.counters["allocs_per_task"] = benchmark::Counter(
+        static_cast<double>(ssts::bench::allocations() - allocations_before),
+        benchmark::Counter::kAvgIterations);
+    s.stop();
+}
+
+BENCHMARK(BM_Scheduler_EveryFire)->UseRealTime();
+BENCHMARK(BM_Scheduler_InFire)->UseRealTime();
+
+static void BM_Scheduler_InThroughput(benchmark::State& state)
+{
+    constexpr std::size_t tasks_per_iteration = 1'000;
+    ssts::task_scheduler s(1);
+    s.start();
+
+    std::atomic<std::size_t> runs{ 0 };
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + tasks_per_iteration;
+        for (std::size_t n = 0; n < tasks_per_iteration; ++n)
+            s.in(0s, [&runs] { runs.fetch_add(1, std::memory_order_release); });
+
+        wait_for_runs(runs, target);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * tasks_per_iteration));
+    s.stop();
+}
+
+static void BM_Scheduler_PostInThroughput(benchmark::State& state)
+{
+    constexpr std::size_t tasks_per_iteration = 1'000;
+    ssts::task_scheduler s(1);
+    s.start();
+
+    std::atomic<std::size_t> runs{ 0 };
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + tasks_per_iteration;
+        for (std::size_t n = 0; n < tasks_per_iteration; ++n)
+            s.post_in(0s, [&runs] { runs.fetch_add(1, std::memory_order_release); });
+
+        wait_for_runs(runs, target);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * tasks_per_iteration));
+    s.stop();
+}
+
+static void BM_Scheduler_AtThroughput(benchmark::State& state)
+{
+    constexpr std::size_t tasks_per_iteration = 1'000;
+    ssts::task_scheduler s(1);
+    s.start();
+
+    std::atomic<std::size_t> runs{ 0 };
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + tasks_per_iteration;
+        for (std::size_t n = 0; n < tasks_per_iteration; ++n)
+            s.at(ssts::clock::now(), [&runs] { runs.fetch_add(1, std::memory_order_release); });
+
+        wait_for_runs(runs, target);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * tasks_per_iteration));
+    s.stop();
+}
+
+// Recursive tasks are inserted with a long interval, so that none of them fires: measures the insertion path only.
+static void BM_Scheduler_EveryInsert(benchmark::State& state)
+{
+    constexpr std::size_t tasks_per_iteration = 1'000;
+    ssts::task_scheduler s(1);
+    s.start();
+
+    for (auto _ : state)
+    {
+        for (std::size_t n = 0; n < tasks_per_iteration; ++n)
+            s.every(1h, [] { });
+
+        benchmark::DoNotOptimize(s.size());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * tasks_per_iteration));
+    s.stop();
+}
+
+BENCHMARK(BM_Scheduler_InThroughput)->UseRealTime();
+BENCHMARK(BM_Scheduler_PostInThroughput)->UseRealTime();
+BENCHMARK(BM_Scheduler_AtThroughput)->UseRealTime();
+BENCHMARK(BM_Scheduler_EveryInsert)->UseRealTime();
+
+// Teardown time of a running scheduler holding N tasks (half of them with a task id): stop() and destruction.
+static void BM_Scheduler_Stop(benchmark::State& state)
+{
+    const auto task_count = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto s = std::make_unique<ssts::task_scheduler>(4);
+        s->start();
+
+        const auto start = ssts::clock::now() + 1h;
+        std::vector<ssts::batch_task> tasks;
+        tasks.reserve(task_count);
+        for (std::size_t n = 0; n < task_count; ++n)
+        {
+            if (n % 2)
+                tasks.emplace_back(start + std::chrono::milliseconds(n), [] { }, "task_" + std::to_string(n));
+            else
+                tasks.emplace_back(start + std::chrono::milliseconds(n), [] { });
+        }
+
+        s->post_batch(tasks.begin(), tasks.end());
+        benchmark::DoNotOptimize(s->size());
+        state.ResumeTiming();
+
+        s->stop();
+        s.reset();
+    }
+}
+
+BENCHMARK(BM_Scheduler_Stop)->Arg(1'000)->Arg(100'000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Producers submitting far-future tasks concurrently: measures the submission path only, as no task is dispatched.
+static void BM_Scheduler_PostInContended(benchmark::State& state)
+{
+    static std::unique_ptr<ssts::task_scheduler> s;
+    if (state.thread_index() == 0)
+    {
+        s = std::make_unique<ssts::task_scheduler>(1);
+        s->start();
+    }
+
+    for (auto _ : state)
+        s->post_in(1h, [] { });
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    if (state.thread_index() == 0)
+        s.reset();
+}
+
+BENCHMARK(BM_Scheduler_PostInContended)->ThreadRange(1, 4)->UseRealTime();
+
+namespace
+{
+
+enum class load_mode { one_by_one, batch, presorted_batch };
+
+// Load n timers with task ids, sorted by time point, into a scheduler that is not started.
+template<typename Scheduler>
+void load_timers(benchmark::State& state, load_mode mode)
+{
+    const auto n_tasks = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto s = std::make_unique<Scheduler>(1);
+        const auto now = ssts::clock::now();
+        std::vector<ssts::batch_task> tasks;
+        if (mode != load_mode::one_by_one)
+        {
+            tasks.reserve(n_tasks);
+            for (std::size_t n = 0; n < n_tasks; ++n)
+                tasks.emplace_back(now + 1h + n * 1us, [] { }, "task_id_"s + std::to_string(n));
+        }
+        state.ResumeTiming();
+
+        if (mode == load_mode::one_by_one)
+        {
+            for (std::size_t n = 0; n < n_tasks; ++n)
+                s->post_at("task_id_"s + std::to_string(n), now + 1h + n * 1us, [] { });
+        }
+        else
+        {
+            s->post_batch(tasks.begin(), tasks.end(), mode == load_mode::presorted_batch);
+        }
+
+        // size() inserts any pending submission into the task queue.
+        benchmark::DoNotOptimize(s->size());
+
+        state.PauseTiming();
+        s.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n_tasks));
+}
+
+}
+
+template<typename Scheduler>
+static void BM_Scheduler_LoadOneByOne(benchmark::State& state) { load_timers<Scheduler>(state, load_mode::one_by_one); }
+
+template<typename Scheduler>
+static void BM_Scheduler_LoadBatch(benchmark::State& state) { load_timers<Scheduler>(state, load_mode::batch); }
+
+template<typename Scheduler>
+static void BM_Scheduler_LoadPresortedBatch(benchmark::State& state) { load_timers<Scheduler>(state, load_mode::presorted_batch); }
+
+using dary_heap_scheduler = ssts::basic_task_scheduler<ssts::dary_heap_queue_policy<>>;
+
+BENCHMARK_TEMPLATE(BM_Scheduler_LoadOneByOne, ssts::task_scheduler)->Arg(10'000)->Arg(500'000)->Unit(benchmark::kMillisecond)->Iterations(3);
+BENCHMARK_TEMPLATE(BM_Scheduler_LoadBatch, ssts::task_scheduler)->Arg(10'000)->Arg(500'000)->Unit(benchmark::kMillisecond)->Iterations(3);
+BENCHMARK_TEMPLATE(BM_Scheduler_LoadPresortedBatch, ssts::task_scheduler)->Arg(10'000)->Arg(500'000)->Unit(benchmark::kMillisecond)->Iterations(3);
+BENCHMARK_TEMPLATE(BM_Scheduler_LoadOneByOne, dary_heap_scheduler)->Arg(10'000)->Arg(500'000)->Unit(benchmark::kMillisecond)->Iterations(3);
+BENCHMARK_TEMPLATE(BM_Scheduler_LoadBatch, dary_heap_scheduler)->Arg(10'000)->Arg(500'000)->Unit(benchmark::kMillisecond)->Iterations(3);
+
+// 10k timers expiring in the same tick: measures dispatch of due tasks from the scheduler thread into the pool.
+static void BM_Scheduler_SameTickDispatch(benchmark::State& state)
+{
+    constexpr std::size_t tasks_per_iteration = 10'000;
+    ssts::pool_options options;
+    options.num_threads = static_cast<unsigned>(state.range(0));
+    ssts::task_scheduler s(options);
+    s.start();
+
+    std::atomic<std::size_t> runs{ 0 };
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        const auto target = runs.load() + tasks_per_iteration;
+        const auto timepoint = ssts::clock::now() + 5ms;
+        std::vector<ssts::batch_task> tasks;
+        for (std::size_t n = 0; n < tasks_per_iteration; ++n)
+            tasks.emplace_back(timepoint, [&runs] { runs.fetch_add(1, std::memory_order_release); });
+
+        s.post_batch(tasks.begin(), tasks.end(), true);
+        std::this_thread::sleep_until(timepoint);
+        state.ResumeTiming();
+
+        wait_for_runs(runs, target);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * tasks_per_iteration));
+    s.stop();
+}
+
+BENCHMARK(BM_Scheduler_SameTickDispatch)->Arg(1)->Arg(4)->UseRealTime();
+
+// Time from a task time point to the task start on a worker, with the scheduler thread and the worker
+// left to the OS (0) or pinned to the last allowed CPU (1): pinning avoids migrations and cross-node cache misses.
+static void BM_Scheduler_DispatchLatency(benchmark::State& state)
+{
+    ssts::scheduler_options options;
+    options.pool.num_threads = 1;
+    if (const auto cpus = ssts::get_thread_affinity(); state.range(0) && !cpus.empty())
+    {
+        options.pool.worker_cpus = { cpus.back() };
+        options.scheduler_cpus = { cpus.back() };
+    }
+
+    ssts::task_scheduler s(options);
+    s.start();
+
+    std::atomic<std::size_t> runs{ 0 };
+    std::atomic<int64_t> total_lateness_ns{ 0 };
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + 1;
+        const auto timepoint = ssts::clock::now() + 200us;
+        s.post_at(ssts::clock::time_point{ timepoint }, [&runs, &total_lateness_ns, timepoint]
+        {
+            total_lateness_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(ssts::clock::now() - timepoint).count());
+            runs.fetch_add(1, std::memory_order_release);
+        });
+        wait_for_runs(runs, target);
+    }
+
+    state.counters["mean_lateness_us"] = static_cast<double>(total_lateness_ns.load()) / 1e3 / static_cast<double>(state.iterations());
+    s.stop();
+}
+
+BENCHMARK(BM_Scheduler_DispatchLatency)->Arg(0)->Arg(1)->UseRealTime();
+
+// Time from a task time point to the task start, with the scheduler thread and the worker parking (0)
+// or busy waiting (1): the scheduler thread spins for the last 50us before each time point, the worker up to 100us.
+static void BM_Scheduler_WaitStrategyLatency(benchmark::State& state)
+{
+    ssts::scheduler_options options;
+    options.pool.num_threads = 1;
+    if (state.range(0))
+    {
+        options.pool.wait = ssts::wait_strategy::spin_then_park(100us);
+        options.wait = ssts::wait_strategy::spin_then_park(50us);
+    }
+
+    ssts::task_scheduler s(options);
+    s.start();
+
+    std::atomic<std::size_t> runs{ 0 };
+    std::atomic<int64_t> total_lateness_ns{ 0 };
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + 1;
+        const auto timepoint = ssts::clock::now() + 200us;
+        s.post_at(ssts::clock::time_point{ timepoint }, [&runs, &total_lateness_ns, timepoint]
+        {
+            total_lateness_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(ssts::clock::now() - timepoint).count());
+            runs.fetch_add(1, std::memory_order_release);
+        });
+        wait_for_runs(runs, target);
+    }
+
+    state.counters["mean_lateness_us"] = static_cast<double>(total_lateness_ns.load()) / 1e3 / static_cast<double>(state.iterations());
+    s.stop();
+}
+
+BENCHMARK(BM_Scheduler_WaitStrategyLatency)->Arg(0)->Arg(1)->UseRealTime();
+
+// Overloaded single worker: each iteration dispatches 4 batches of 100 already late tasks (20us each), 1ms apart,
+// with random lateness up to 8ms. Lateness percentiles show the effect of the pool queue order:
+// FIFO (0) serves batches in arrival order, EDF (1) always runs the most overdue task.
+static void BM_Scheduler_OverloadLateness(benchmark::State& state)
+{
+    constexpr std::size_t batch_count = 4;
+    constexpr std::size_t tasks_per_batch = 100;
+
+    std::mutex lateness_mtx;
+    std::vector<ssts::clock::duration> lateness;
+    lateness.reserve(1'000'000);
+
+    ssts::pool_options options;
+    options.num_threads = 1;
+    options.order = state.range(0) ? ssts::queue_order::earliest_deadline_first : ssts::queue_order::fifo;
+    options.starvation_timeout = std::chrono::hours(1);
+    options.lateness_callback = [&lateness_mtx, &lateness](size_t, ssts::clock::duration l)
+    {
+        std::scoped_lock lock(lateness_mtx);
+        lateness.push_back(l);
+    };
+
+    ssts::task_scheduler s(options);
+    s.start();
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int64_t> lateness_us(0, 8'000);
+    std::atomic<std::size_t> runs{ 0 };
+    auto busy_task = [&runs]
+    {
+        const auto end = ssts::clock::now() + 20us;
+        while (ssts::clock::now() < end) { }
+        runs.fetch_add(1, std::memory_order_release);
+    };
+
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + batch_count * tasks_per_batch;
+        for (std::size_t b = 0; b < batch_count; ++b)
+        {
+            const auto now = ssts::clock::now();
+            std::vector<ssts::batch_task> tasks;
+            for (std::size_t n = 0; n < tasks_per_batch; ++n)
+                tasks.emplace_back(now - std::chrono::microseconds(lateness_us(rng)), busy_task);
+
+            s.post_batch(tasks.begin(), tasks.end());
+            std::this_thread::sleep_for(1ms);
+        }
+
+        wait_for_runs(runs, target);
+    }
+
+    s.stop();
+
+    std::sort(lateness.begin(), lateness.end());
+    auto percentile_us = [&lateness](double p)
+    {
+        const auto index = static_cast<std::size_t>(p * static_cast<double>(lateness.size() - 1));
+        return std::chrono::duration<double, std::micro>(lateness[index]).count();
+    };
+
+    state.counters["p50_lateness_us"] = percentile_us(0.5);
+    state.counters["p99_lateness_us"] = percentile_us(0.99);
+    state.counters["max_lateness_us"] = percentile_us(1.0);
+}
+
+BENCHMARK(BM_Scheduler_OverloadLateness)->Arg(0)->Arg(1)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Firing accuracy of the scheduler thread timer: each iteration schedules a task 1ms ahead and waits for it.
+// Lateness is measured by the pool when the task starts, for the condition_variable (0) and timerfd (1) backends.
+static void BM_Scheduler_TimerJitter(benchmark::State& state)
+{
+    std::mutex lateness_mtx;
+    std::vector<ssts::clock::duration> lateness;
+    lateness.reserve(1'000'000);
+
+    ssts::scheduler_options options;
+    options.pool.num_threads = 1;
+    options.timer = state.range(0) ? ssts::timer_backend::timerfd : ssts::timer_backend::condition_variable;
+    options.pool.lateness_callback = [&lateness_mtx, &lateness](size_t, ssts::clock::duration l)
+    {
+        std::scoped_lock lock(lateness_mtx);
+        lateness.push_back(l);
+    };
+
+    ssts::task_scheduler s(options);
+    s.start();
+
+    std::atomic<std::size_t> runs{ 0 };
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + 1;
+        s.post_in(1ms, [&runs]{ runs.fetch_add(1, std::memory_order_release); });
+        wait_for_runs(runs, target);
+    }
+
+    s.stop();
+
+    std::sort(lateness.begin(), lateness.end());
+    auto percentile_us = [&lateness](double p)
+    {
+        const auto index = static_cast<std::size_t>(p * static_cast<double>(lateness.size() - 1));
+        return std::chrono::duration<double, std::micro>(lateness[index]).count();
+    };
+
+    state.counters["p50_lateness_us"] = percentile_us(0.5);
+    state.counters["p99_lateness_us"] = percentile_us(0.99);
+    state.counters["max_lateness_us"] = percentile_us(1.0);
+}
+
+BENCHMARK(BM_Scheduler_TimerJitter)->Arg(0)->Arg(1)->UseRealTime()->Iterations(2000);
+
+// 500 periodic tasks (50ms interval) with time points 100us apart, run for 50ms per iteration,
+// without slack (0) and with 1ms timer slack (1000): wake-ups saved by coalescing and the resulting lateness.
+static void BM_Scheduler_TimerSlackCoalescing(benchmark::State& state)
+{
+    constexpr std::size_t task_count = 500;
+
+    std::mutex lateness_mtx;
+    std::vector<ssts::clock::duration> lateness;
+    lateness.reserve(1'000'000);
+
+    ssts::scheduler_options options;
+    options.pool.num_threads = 1;
+    options.timer_slack = std::chrono::microseconds(state.range(0));
+    options.pool.lateness_callback = [&lateness_mtx, &lateness](size_t, ssts::clock::duration l)
+    {
+        std::scoped_lock lock(lateness_mtx);
+        lateness.push_back(l);
+    };
+
+    ssts::task_scheduler s(options);
+    s.start();
+
+    const auto start = ssts::clock::now() + 10ms;
+    std::vector<ssts::batch_task> tasks;
+    for (std::size_t n = 0; n < task_count; ++n)
+        tasks.emplace_back(start + n * 100us, []{ }, std::nullopt, 50ms);
+
+    s.post_batch(tasks.begin(), tasks.end());
+
+    std::this_thread::sleep_until(start + 50ms);
+    const auto wakeups_saved_before = s.wakeups_saved();
+    for (auto _ : state)
+        std::this_thread::sleep_for(50ms);
+
+    const auto wakeups_saved = s.wakeups_saved() - wakeups_saved_before;
+    s.stop();
+
+    std::sort(lateness.begin(), lateness.end());
+    state.counters["wakeups_saved_per_s"] = benchmark::Counter(static_cast<double>(wakeups_saved), benchmark::Counter::kIsRate);
+    state.counters["p50_lateness_us"] = std::chrono::duration<double, std::micro>(lateness[lateness.size() / 2]).count();
+    state.counters["max_lateness_us"] = std::chrono::duration<double, std::micro>(lateness.back()).count();
+}
+
+BENCHMARK(BM_Scheduler_TimerSlackCoalescing)->Arg(0)->Arg(1000)->UseRealTime()->Iterations(20)->Unit(benchmark::kMillisecond);
+
+// Dispatch latency of a task scheduled 1ms ahead, through the scheduler thread (0)
+// or run by the pool worker that waits for the time point as timer leader (1).
+static void BM_Scheduler_DispatchModeLatency(benchmark::State& state)
+{
+    std::mutex lateness_mtx;
+    std::vector<ssts::clock::duration> lateness;
+    lateness.reserve(1'000'000);
+
+    ssts::scheduler_options options;
+    options.pool.num_threads = 2;
+    options.dispatch = state.range(0) ? ssts::dispatch_mode::leader_follower : ssts::dispatch_mode::scheduler_thread;
+    options.pool.lateness_callback = [&lateness_mtx, &lateness](size_t, ssts::clock::duration l)
+    {
+        std::scoped_lock lock(lateness_mtx);
+        lateness.push_back(l);
+    };
+
+    ssts::task_scheduler s(options);
+    s.start();
+
+    std::atomic<std::size_t> runs{ 0 };
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + 1;
+        s.post_in(1ms, [&runs]{ runs.fetch_add(1, std::memory_order_release); });
+        wait_for_runs(runs, target);
+    }
+
+    s.stop();
+
+    std::sort(lateness.begin(), lateness.end());
+    auto percentile_us = [&lateness](double p)
+    {
+        const auto index = static_cast<std::size_t>(p * static_cast<double>(lateness.size() - 1));
+        return std::chrono::duration<double, std::micro>(lateness[index]).count();
+    };
+
+    state.counters["p50_lateness_us"] = percentile_us(0.5);
+    state.counters["p99_lateness_us"] = percentile_us(0.99);
+}
+
+BENCHMARK(BM_Scheduler_DispatchModeLatency)->Arg(0)->Arg(1)->UseRealTime()->Iterations(2000);
+
+static void BM_LatencyHistogram_Record(benchmark::State& state)
+{
+    ssts::latency_histogram h;
+    std::mt19937_64 rng{ 42 };
+    std::vector<ssts::clock::duration> samples(4096);
+    for (auto& d : samples)
+        d = std::chrono::nanoseconds(rng() % 10'000'000);
+
+    std::size_t n = 0;
+    for (auto _ : state)
+        h.record(samples[n++ & (samples.size() - 1)]);
+
+    benchmark::DoNotOptimize(h.count());
+}
+
+BENCHMARK(BM_LatencyHistogram_Record);
+
+// Cost of lateness statistics on the fire path: throughput of due tasks with stats disabled (0) and enabled (1).
+static void BM_Scheduler_StatsOverhead(benchmark::State& state)
+{
+    constexpr std::size_t tasks_per_iteration = 1'000;
+    ssts::scheduler_options options;
+    options.pool.num_threads = 1;
+    options.pool.lateness_stats = state.range(0) != 0;
+    ssts::task_scheduler s(options);
+    s.start();
+
+    std::atomic<std::size_t> runs{ 0 };
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + tasks_per_iteration;
+        for (std::size_t n = 0; n < tasks_per_iteration; ++n)
+            s.post_in(0s, [&runs] { runs.fetch_add(1, std::memory_order_release); });
+
+        wait_for_runs(runs, target);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * tasks_per_iteration));
+    s.stop();
+}
+
+BENCHMARK(BM_Scheduler_StatsOverhead)->Arg(0)->Arg(1)->UseRealTime();
+
+// Cost of per task metrics: throughput of due tasks with a task_id, with metrics disabled (0) and enabled (1).
+static void BM_Scheduler_TaskMetricsOverhead(benchmark::State& state)
+{
+    constexpr std::size_t tasks_per_iteration = 1'000;
+    ssts::scheduler_options options;
+    options.pool.num_threads = 1;
+    options.per_task_metrics = state.range(0) != 0;
+    ssts::task_scheduler s(options);
+    s.start();
+
+    std::atomic<std::size_t> runs{ 0 };
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + tasks_per_iteration;
+        for (std::size_t n = 0; n < tasks_per_iteration; ++n)
+            s.post_in("task_id"s, 0s, [&runs] { runs.fetch_add(1, std::memory_order_release); });
+
+        wait_for_runs(runs, target);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * tasks_per_iteration));
+    s.stop();
+}
+
+BENCHMARK(BM_Scheduler_TaskMetricsOverhead)->Arg(0)->Arg(1)->UseRealTime();
+
+// Cost of recording one trace event (the tracer is always available, SSTS_ENABLE_TRACING only compiles in the hooks).
+static void BM_Trace_Record(benchmark::State& state)
+{
+    auto& t = ssts::tracer::instance();
+    uint64_t hash = 0;
+    for (auto _ : state)
+        t.record(ssts::trace_event::enqueue, ++hash);
+
+    t.clear();
+}
+
+BENCHMARK(BM_Trace_Record);
+
+// Dispatch of a recursive task (1ms interval) that is state.range(0) intervals late, e.g. after a long stall:
+// the next time point is computed in constant time, whatever the number of missed runs.
+static void BM_Scheduler_CatchUp(benchmark::State& state)
+{
+    ssts::pool_options options;
+    options.num_threads = 1;
+    ssts::task_scheduler s(options);
+    s.start();
+
+    std::atomic<std::size_t> runs{ 0 };
+    std::vector<ssts::batch_task> tasks;
+    for (auto _ : state)
+    {
+        const auto target = runs.load() + 1;
+        tasks.emplace_back(ssts::clock::now() - std::chrono::milliseconds(state.range(0)), [&runs] { runs.fetch_add(1, std::memory_order_release); }, "late"s, 1ms);
+        s.post_batch(tasks.begin(), tasks.end());
+        tasks.clear();
+
+        wait_for_runs(runs, target);
+        s.remove_task("late"s);
+    }
+
+    s.stop();
+}
+
+BENCHMARK(BM_Scheduler_CatchUp)->Arg(1'000)->Arg(1'000'000)->Arg(1'000'000'000)->UseRealTime();
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+#include <ssts/task.hpp>
+#include <array>
+#include <memory>
+
+#include "alloc_counter.hpp"
+
+namespace
+{
+
+// Reference implementation of the former ssts::task:
+// one heap allocation per task and a virtual call on invoke.
+class heap_task
+{
+    struct task_base
+    {
+        virtual ~task_base() { }
+        virtual void invoke() = 0;
+    };
+
+    template<typename FunctionType>
+    struct task_impl : task_base
+    {
+        explicit task_impl(FunctionType&& f) : _func{ std::move(f) } { }
+        void invoke() override { _func(); }
+        FunctionType _func;
+    };
+
+public:
+    template<typename FunctionType>
+    explicit heap_task(FunctionType&& f) : _impl{ std::make_unique<task_impl<FunctionType>>(std::move(f)) } { }
+    void invoke() { _impl->invoke(); }
+
+private:
+    std::unique_ptr<task_base> _impl;
+};
+
+template<std::size_t CaptureSize>
+struct capture
+{
+    std::array<char, CaptureSize> data{};
+};
+
+template<typename TaskType, std::size_t CaptureSize>
+void BM_Task_CreateInvoke(benchmark::State& state)
+{
+    int counter = 0;
+    const auto allocations_before = ssts::bench::allocations();
+
+    for (auto _ : state)
+    {
+        TaskType t([&counter, c = capture<CaptureSize>{}] { counter += c.data[0] + 1; });
+        t.invoke();
+    }
+
+    benchmark::DoNotOptimize(counter);
+    state.counters["allocs_per_task"] = benchmark::Counter(
+        static_cast<double>(ssts::bench::allocations() - allocations_before),
+        benchmark::Counter::kAvgIterations);
+}
+
+}
+
+BENCHMARK_TEMPLATE(BM_Task_CreateInvoke, heap_task, 8);
+BENCHMARK_TEMPLATE(BM_Task_CreateInvoke, ssts::task, 8);
+BENCHMARK_TEMPLATE(BM_Task_CreateInvoke, heap_task, 32);
+BENCHMARK_TEMPLATE(BM_Task_CreateInvoke, ssts::task, 32);
+BENCHMARK_TEMPLATE(BM_Task_CreateInvoke, heap_task, 128);
+BENCHMARK_TEMPLATE(BM_Task_CreateInvoke, ssts::task, 128);
+BENCHMARK_TEMPLATE(BM_Task_CreateInvoke, ssts::basic_task<160>, 128);
@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+#include <ssts/task_scheduler.hpp>
+#include <string>
+
+namespace
+{
+
+void schedule_tasks(ssts::task_scheduler& s, std::size_t n_tasks)
+{
+    for (std::size_t n = 0; n < n_tasks; ++n)
+        s.post_in("task_id_"s + std::to_string(n), 1h, [] { });
+}
+
+std::string task_id(std::size_t n) { return "task_id_"s + std::to_string(n); }
+
+}
+
+static void BM_TaskId_IsScheduled(benchmark::State& state)
+{
+    const auto n_tasks = static_cast<std::size_t>(state.range(0));
+    ssts::task_scheduler s(1);
+    s.start();
+    schedule_tasks(s, n_tasks);
+
+    const auto id = task_id(n_tasks - 1);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(s.is_scheduled(id));
+
+    s.stop();
+}
+
+static void BM_TaskId_SetEnabled(benchmark::State& state)
+{
+    const auto n_tasks = static_cast<std::size_t>(state.range(0));
+    ssts::task_scheduler s(1);
+    s.start();
+    schedule_tasks(s, n_tasks);
+
+    const auto id = task_id(n_tasks - 1);
+    bool is_enabled = false;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(s.set_enabled(id, is_enabled));
+        is_enabled = !is_enabled;
+    }
+
+    s.stop();
+}
+
+static void BM_TaskId_RemoveAdd(benchmark::State& state)
+{
+    const auto n_tasks = static_cast<std::size_t>(state.range(0));
+    ssts::task_scheduler s(1);
+    s.start();
+    schedule_tasks(s, n_tasks);
+
+    const auto id = task_id(n_tasks - 1);
+    for (auto _ : state)
+    {
+        s.remove_task(id);
+        s.post_in(std::string(id), 1h, [] { });
+    }
+
+    s.stop();
+}
+
+static void BM_TaskId_UpdateInterval(benchmark::State& state)
+{
+    const auto n_tasks = static_cast<std::size_t>(state.range(0));
+    ssts::task_scheduler s(1);
+    s.start();
+    schedule_tasks(s, n_tasks - 1);
+    s.every(task_id(n_tasks - 1), 1h, [] { });
+
+    const auto id = task_id(n_tasks - 1);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(s.update_interval(id, 1h));
+
+    s.stop();
+}
+
+BENCHMARK(BM_TaskId_IsScheduled)->Arg(1'000)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_TaskId_SetEnabled)->Arg(1'000)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_TaskId_RemoveAdd)->Arg(1'000)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_TaskId_UpdateInterval)->Arg(1'000)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kNanosecond);
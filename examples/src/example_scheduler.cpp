@@ -99,6 +99,27 @@ void t_task_pool_size_too_small()
     std::this_thread::sleep_for(10s);
 }
 
+void t_task_pool_size_too_small_priority()
+{
+    /*
+    Same workload as t_task_pool_size_too_small, plus a heartbeat every 100ms.
+    The heartbeat still waits for a free thread, but it is dequeued before all the queued bulk tasks.
+    */
+
+    ssts::utils::log_test("Task pool size - Too small, high priority heartbeat");
+    
+    ssts::task_scheduler s(2);
+
+    ssts::utils::timer t;
+
+    s.every(100ms, []{std::cout << "Hello A!" << std::endl; std::this_thread::sleep_for(2s);});
+    s.every(100ms, []{std::cout << "Hello B!" << std::endl; std::this_thread::sleep_for(2s);});
+    s.every(100ms, []{std::cout << "Hello C!" << std::endl; std::this_thread::sleep_for(2s);});
+    s.every(ssts::priority::high, 100ms, []{std::cout << "Heartbeat!" << std::endl;});
+
+    std::this_thread::sleep_for(10s);
+}
+
 void t_in()
 {
     /// task_scheduler::in() APIs
@@ -289,6 +310,7 @@ int main()
     t_every();
 
     t_task_pool_size_too_small();  // Fixed deadlock on scheduler shutdown.
+    t_task_pool_size_too_small_priority();
     t_task_pool_size_ok(); // Fixed deadlock on scheduler shutdown.
 
     t_disable();
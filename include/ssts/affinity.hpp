@@ -0,0 +1,138 @@
+/*!
+ * \file affinity.hpp
+ * \author Stefano Lusardi
+ */
+
+#pragma once
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace ssts
+{
+/*!
+ * \brief Parse a CPU list in the Linux sysfs format.
+ * \param cpu_list Comma separated CPU indices and ranges (e.g. "0-3,8,10-11").
+ * \return std::vector<unsigned int> CPU indices, in the order they appear in cpu_list.
+ */
+inline std::vector<unsigned int> parse_cpu_list(const std::string& cpu_list)
+{
+    std::vector<unsigned int> cpus;
+    std::stringstream ss(cpu_list);
+    std::string range;
+
+    while (std::getline(ss, range, ','))
+    {
+        if (range.empty() || range.find_first_not_of(" \n") == std::string::npos)
+            continue;
+
+        try
+        {
+            const auto dash = range.find('-');
+            const auto first = static_cast<unsigned int>(std::stoul(range.substr(0, dash)));
+            const auto last = dash == std::string::npos ? first : static_cast<unsigned int>(std::stoul(range.substr(dash + 1)));
+            for (auto cpu = first; cpu <= last; ++cpu)
+                cpus.push_back(cpu);
+        }
+        catch (const std::exception&)
+        {
+            return {};
+        }
+    }
+
+    return cpus;
+}
+
+/*!
+ * \brief Get the CPUs of a NUMA node.
+ * \param node NUMA node index.
+ * \return std::vector<unsigned int> CPU indices of the node, empty if the node does not exist or NUMA topology is not available.
+ *
+ * The topology is read from /sys/devices/system/node on Linux. On other platforms the result is always empty.
+ */
+inline std::vector<unsigned int> numa_node_cpus(unsigned int node)
+{
+#if defined(__linux__)
+    std::ifstream cpu_list_file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string cpu_list;
+    if (cpu_list_file && std::getline(cpu_list_file, cpu_list))
+        return parse_cpu_list(cpu_list);
+#else
+    (void)node;
+#endif
+    return {};
+}
+
+/*!
+ * \brief Get the number of NUMA nodes.
+ * \return unsigned int number of NUMA nodes with CPUs, 1 if NUMA topology is not available.
+ */
+inline unsigned int numa_node_count()
+{
+    unsigned int count = 0;
+    while (!numa_node_cpus(count).empty())
+        ++count;
+
+    return count > 0 ? count : 1;
+}
+
+/*!
+ * \brief Restrict the calling thread to the given CPUs.
+ * \param cpus CPU indices the calling thread is allowed to run on.
+ * \return bool indicating if the affinity has been set.
+ *
+ * Implemented with pthread_setaffinity_np on Linux. On other platforms the call has no effect and returns false.
+ */
+inline bool set_thread_affinity(const std::vector<unsigned int>& cpus)
+{
+    if (cpus.empty())
+        return false;
+
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (auto cpu : cpus)
+    {
+        if (cpu >= CPU_SETSIZE)
+            return false;
+
+        CPU_SET(cpu, &cpu_set);
+    }
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) == 0;
+#else
+    return false;
+#endif
+}
+
+/*!
+ * \brief Get the CPUs the calling thread is allowed to run on.
+ * \return std::vector<unsigned int> CPU indices, empty if the affinity cannot be queried on this platform.
+ */
+inline std::vector<unsigned int> get_thread_affinity()
+{
+    std::vector<unsigned int> cpus;
+
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) != 0)
+        return cpus;
+
+    for (unsigned int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &cpu_set))
+            cpus.push_back(cpu);
+#endif
+
+    return cpus;
+}
+
+}
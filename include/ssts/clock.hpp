@@ -0,0 +1,34 @@
+/*!
+ * \file clock.hpp
+ * \author Stefano Lusardi
+ */
+
+#pragma once
+
+#include <chrono>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <time.h>
+#endif
+
+namespace ssts
+{
+/*! \typedef clock Alias for std::chrono::steady_clock.
+ */
+using clock = std::chrono::steady_clock;
+
+/*!
+ * \brief Get the CPU time consumed by the calling thread.
+ * \return std::chrono::nanoseconds of CPU time (CLOCK_THREAD_CPUTIME_ID), zero on platforms that do not provide it.
+ */
+inline std::chrono::nanoseconds thread_cpu_time()
+{
+#if (defined(__unix__) || defined(__APPLE__)) && defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts{};
+    if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+        return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+#endif
+    return std::chrono::nanoseconds{ 0 };
+}
+
+}
@@ -0,0 +1,260 @@
+/*!
+ * \file dary_heap_queue.hpp
+ * \author Stefano Lusardi
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "clock.hpp"
+
+namespace ssts
+{
+/*! \class dary_heap_queue
+ *  \brief Timer queue based on a d-ary min-heap stored in a contiguous array.
+ *
+ *  Heap entries only hold a time point and a slot index, so that the Arity children of a node
+ *  are adjacent in memory (with the default Arity of 4 they fit a single 64 byte cache line).
+ *  Values are stored in a separate slot table and never move: a handle is a slot index,
+ *  stable until the value is erased, and each slot keeps track of its heap position.
+ *
+ *  Insert, erase and reschedule are O(log n) sifts on the array, collect_due is O(k log n)
+ *  where k is the number of due values. Slots are recycled through a free list, hence no allocation takes place
+ *  after the queue has reached its steady state size.
+ *  Values with the same time point are collected in unspecified order.
+ *  See ssts::multimap_queue for a description of the timer queue interface.
+ *
+ *  \tparam T Type of the queued values.
+ *  \tparam Arity Number of children of each heap node.
+ */
+template<typename T, size_t Arity = 4>
+class dary_heap_queue
+{
+    static_assert(Arity >= 2, "dary_heap_queue requires Arity >= 2");
+
+    static constexpr size_t detached = std::numeric_limits<size_t>::max();
+
+    struct heap_entry
+    {
+        ssts::clock::time_point timepoint;
+        size_t slot;
+    };
+
+    struct slot_entry
+    {
+        std::optional<T> value;
+        ssts::clock::time_point timepoint;
+        size_t heap_position;
+    };
+
+public:
+    using handle = size_t;
+
+    handle insert(const ssts::clock::time_point& timepoint, T&& value)
+    {
+        const auto h = allocate_slot();
+        _slots[h].value.emplace(std::move(value));
+        _slots[h].timepoint = timepoint;
+        push(h);
+        ++_size;
+        return h;
+    }
+
+    // Values inserted in time order are never sifted up past earlier values (an array sorted by time is a heap): hints are not needed.
+    handle insert(handle, const ssts::clock::time_point& timepoint, T&& value) { return insert(timepoint, std::move(value)); }
+
+    void erase(handle h)
+    {
+        if (_slots[h].heap_position != detached)
+            remove_at(_slots[h].heap_position);
+
+        _slots[h].value.reset();
+        _free_slots.push_back(h);
+        --_size;
+    }
+
+    handle reschedule(handle h, const ssts::clock::time_point& timepoint)
+    {
+        auto& s = _slots[h];
+        s.timepoint = timepoint;
+
+        if (s.heap_position == detached)
+        {
+            push(h);
+            return h;
+        }
+
+        const auto position = s.heap_position;
+        const auto previous = _heap[position].timepoint;
+        _heap[position].timepoint = timepoint;
+
+        if (timepoint < previous)
+            sift_up(position);
+        else
+            sift_down(position);
+
+        return h;
+    }
+
+    T& value(handle h) { return *_slots[h].value; }
+    ssts::clock::time_point time_point(handle h) const { return _slots[h].timepoint; }
+
+    bool empty() const { return _size == 0; }
+    size_t size() const { return _size; }
+
+    void clear()
+    {
+        _heap.clear();
+        _slots.clear();
+        _free_slots.clear();
+        _size = 0;
+    }
+
+    ssts::clock::time_point next_time_point() const
+    {
+        return _heap.empty() ? ssts::clock::time_point::max() : _heap.front().timepoint;
+    }
+
+    void collect_due(const ssts::clock::time_point& now, std::vector<handle>& due)
+    {
+        while (!_heap.empty() && _heap.front().timepoint <= now)
+        {
+            due.push_back(_heap.front().slot);
+            remove_at(0);
+        }
+    }
+
+    // Subtrees whose root is not earlier than the limit are skipped, as every child is not earlier than its parent.
+    template<typename Function>
+    void for_each_before(ssts::clock::time_point limit, Function&& f)
+    {
+        visit_before(0, limit, f);
+    }
+
+private:
+    std::vector<heap_entry> _heap;
+    std::vector<slot_entry> _slots;
+    std::vector<size_t> _free_slots;
+    size_t _size = 0;
+
+    template<typename Function>
+    void visit_before(size_t position, ssts::clock::time_point& limit, Function& f)
+    {
+        if (position >= _heap.size() || _heap[position].timepoint >= limit)
+            return;
+
+        limit = f(_heap[position].slot);
+        for (size_t child = Arity * position + 1; child <= Arity * position + Arity; ++child)
+            visit_before(child, limit, f);
+    }
+
+    handle allocate_slot()
+    {
+        if (!_free_slots.empty())
+        {
+            const auto h = _free_slots.back();
+            _free_slots.pop_back();
+            return h;
+        }
+
+        _slots.emplace_back();
+        return _slots.size() - 1;
+    }
+
+    void push(handle h)
+    {
+        _heap.push_back({ _slots[h].timepoint, h });
+        _slots[h].heap_position = _heap.size() - 1;
+        sift_up(_heap.size() - 1);
+    }
+
+    // Detach the entry at the given heap position, filling the hole with the last entry.
+    void remove_at(size_t position)
+    {
+        _slots[_heap[position].slot].heap_position = detached;
+
+        const auto last = _heap.size() - 1;
+        if (position != last)
+        {
+            const auto previous = _heap[position].timepoint;
+            place(position, _heap[last]);
+            _heap.pop_back();
+
+            if (_heap[position].timepoint < previous)
+                sift_up(position);
+            else
+                sift_down(position);
+        }
+        else
+        {
+            _heap.pop_back();
+        }
+    }
+
+    void place(size_t position, const heap_entry& entry)
+    {
+        _heap[position] = entry;
+        _slots[entry.slot].heap_position = position;
+    }
+
+    void sift_up(size_t position)
+    {
+        const auto entry = _heap[position];
+        while (position > 0)
+        {
+            const auto parent = (position - 1) / Arity;
+            if (!(entry.timepoint < _heap[parent].timepoint))
+                break;
+
+            place(position, _heap[parent]);
+            position = parent;
+        }
+
+        place(position, entry);
+    }
+
+    void sift_down(size_t position)
+    {
+        const auto entry = _heap[position];
+        const auto count = _heap.size();
+
+        while (true)
+        {
+            const auto first_child = position * Arity + 1;
+            if (first_child >= count)
+                break;
+
+            const auto last_child = std::min(first_child + Arity, count);
+            auto min_child = first_child;
+            for (auto child = first_child + 1; child < last_child; ++child)
+                if (_heap[child].timepoint < _heap[min_child].timepoint)
+                    min_child = child;
+
+            if (!(_heap[min_child].timepoint < entry.timepoint))
+                break;
+
+            place(position, _heap[min_child]);
+            position = min_child;
+        }
+
+        place(position, entry);
+    }
+};
+
+/*! \struct dary_heap_queue_policy
+ *  \brief ssts::basic_task_scheduler policy selecting ssts::dary_heap_queue.
+ *  \tparam Arity Number of children of each heap node.
+ */
+template<size_t Arity = 4>
+struct dary_heap_queue_policy
+{
+    template<typename T>
+    using queue_type = dary_heap_queue<T, Arity>;
+};
+
+}
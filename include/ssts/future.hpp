@@ -0,0 +1,349 @@
+/*!
+ * \file future.hpp
+ * \author Stefano Lusardi
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "task.hpp"
+
+namespace ssts
+{
+template<typename T> class future;
+template<typename T> class promise;
+
+namespace detail
+{
+struct empty_value { };
+
+template<typename T>
+using stored_type = std::conditional_t<std::is_void_v<T>, empty_value, T>;
+
+/*
+ * Shared state between an ssts::promise and an ssts::future.
+ * Readiness, continuation and waiter registration are tracked by a single atomic word:
+ * the mutex and condition variable used for blocking are only allocated if the consumer actually blocks.
+ */
+template<typename T>
+class shared_state
+{
+    enum : unsigned { ready = 1u, has_continuation = 2u, has_waiter = 4u, satisfied = 8u };
+
+    struct waiter
+    {
+        std::mutex mtx;
+        std::condition_variable cv;
+    };
+
+public:
+    bool is_ready() const { return _flags.load(std::memory_order_acquire) & ready; }
+
+    // The state is claimed before storing the result, so that a second set_value() or set_exception()
+    // throws without touching the stored result (that the consumer may already be reading).
+    template<typename... Args>
+    void set_value(Args&&... args)
+    {
+        claim();
+        try
+        {
+            _value.emplace(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            _flags.fetch_and(~satisfied, std::memory_order_relaxed);
+            throw;
+        }
+
+        mark_ready();
+    }
+
+    void set_exception(std::exception_ptr e)
+    {
+        claim();
+        _exception = std::move(e);
+        mark_ready();
+    }
+
+    // Run the continuation immediately if the state is already ready,
+    // otherwise the continuation is run by the thread that makes the state ready.
+    void set_continuation(ssts::task&& continuation)
+    {
+        _continuation.emplace(std::move(continuation));
+        if (_flags.fetch_or(has_continuation, std::memory_order_acq_rel) & ready)
+            run_continuation();
+    }
+
+    void wait()
+    {
+        if (is_ready())
+            return;
+
+        if (!_waiter)
+            _waiter = std::make_unique<waiter>();
+
+        std::unique_lock lock(_waiter->mtx);
+        if (_flags.fetch_or(has_waiter, std::memory_order_acq_rel) & ready)
+            return;
+
+        _waiter->cv.wait(lock, [this] { return is_ready(); });
+    }
+
+    stored_type<T> get()
+    {
+        wait();
+        if (_exception)
+            std::rethrow_exception(_exception);
+
+        return std::move(*_value);
+    }
+
+    std::exception_ptr exception() const { return _exception; }
+    stored_type<T>& value() { return *_value; }
+
+private:
+    std::atomic<unsigned> _flags{ 0 };
+    std::optional<stored_type<T>> _value;
+    std::exception_ptr _exception;
+    std::optional<ssts::task> _continuation;
+    std::unique_ptr<waiter> _waiter;
+
+    void claim()
+    {
+        if (_flags.fetch_or(satisfied, std::memory_order_relaxed) & satisfied)
+            throw std::future_error(std::future_errc::promise_already_satisfied);
+    }
+
+    // Publish the result stored after claim().
+    void mark_ready()
+    {
+        const auto flags = _flags.fetch_or(ready, std::memory_order_acq_rel);
+        if (flags & has_waiter)
+        {
+            std::scoped_lock lock(_waiter->mtx);
+            _waiter->cv.notify_all();
+        }
+
+        if (flags & has_continuation)
+            run_continuation();
+    }
+
+    void run_continuation()
+    {
+        auto continuation = std::move(*_continuation);
+        _continuation.reset();
+        continuation();
+    }
+};
+
+template<typename T, typename FunctionType, typename... Args>
+void set_promise_from(ssts::promise<T>& p, FunctionType&& f, Args&&... args)
+{
+    try
+    {
+        if constexpr (std::is_void_v<T>)
+        {
+            std::invoke(f, std::forward<Args>(args)...);
+            p.set_value();
+        }
+        else
+        {
+            p.set_value(std::invoke(f, std::forward<Args>(args)...));
+        }
+    }
+    catch (...)
+    {
+        p.set_exception(std::current_exception());
+    }
+}
+}
+
+/*! \class promise
+ *  \brief Producer side of an ssts::future.
+ *
+ *  Lightweight alternative to std::promise: setting a value never locks a mutex unless
+ *  the corresponding ssts::future is blocked in ssts::future::get or ssts::future::wait,
+ *  and any continuation attached with ssts::future::then runs on the thread that sets the value.
+ */
+template<typename T>
+class promise
+{
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * Creates a promise with a new shared state.
+     */
+    promise()
+    : _state{ std::make_shared<detail::shared_state<T>>() }
+    , _is_future_retrieved{ false }
+    {
+    }
+
+    promise(const promise&) = delete;
+    promise& operator=(const promise&) = delete;
+
+    promise(promise&& other) noexcept = default;
+    promise& operator=(promise&& other) = delete;
+
+    /*!
+     * \brief Destructor.
+     *
+     * If the shared state is not ready yet it is made ready with a std::future_error (broken_promise).
+     */
+    ~promise()
+    {
+        if (_state && !_state->is_ready())
+            _state->set_exception(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+    }
+
+    /*!
+     * \brief Get the future associated to this promise.
+     * \return ssts::future sharing the state with this promise.
+     *
+     * Throws std::future_error if called more than once.
+     */
+    ssts::future<T> get_future()
+    {
+        if (_is_future_retrieved)
+            throw std::future_error(std::future_errc::future_already_retrieved);
+
+        _is_future_retrieved = true;
+        return ssts::future<T>(_state);
+    }
+
+    /*!
+     * \brief Store a value into the shared state and make it ready.
+     * \param args Arguments forwarded to the value constructor (none for promise<void>).
+     */
+    template<typename... Args>
+    void set_value(Args&&... args) { _state->set_value(std::forward<Args>(args)...); }
+
+    /*!
+     * \brief Store an exception into the shared state and make it ready.
+     * \param e Exception pointer.
+     */
+    void set_exception(std::exception_ptr e) { _state->set_exception(std::move(e)); }
+
+private:
+    std::shared_ptr<detail::shared_state<T>> _state;
+    bool _is_future_retrieved;
+};
+
+/*! \class future
+ *  \brief Consumer side of an ssts::promise.
+ *
+ *  Move-only handle to an asynchronous result.
+ *  The result can be retrieved by blocking (ssts::future::get) or consumed by attaching a continuation (ssts::future::then).
+ */
+template<typename T>
+class future
+{
+public:
+    future() = default;
+
+    future(const future&) = delete;
+    future& operator=(const future&) = delete;
+
+    future(future&& other) noexcept = default;
+    future& operator=(future&& other) noexcept = default;
+
+    /*!
+     * \brief Check if this future refers to a shared state.
+     * \return bool false if default constructed, or after get() or then() have been called.
+     */
+    bool valid() const { return _state != nullptr; }
+
+    /*!
+     * \brief Check if the result is available.
+     * \return bool indicating if get() would not block.
+     */
+    bool is_ready() const { return _state->is_ready(); }
+
+    /*!
+     * \brief Block until the result is available.
+     */
+    void wait() const { _state->wait(); }
+
+    /*!
+     * \brief Get the result.
+     * \return The value stored in the shared state.
+     *
+     * Blocks until the result is available. If an exception has been stored it is rethrown.
+     * After this call valid() is false.
+     */
+    T get()
+    {
+        auto state = std::move(_state);
+        if constexpr (std::is_void_v<T>)
+            state->get();
+        else
+            return state->get();
+    }
+
+    /*!
+     * \brief Attach a continuation.
+     * \param f Callable object invoked with the result (or with no parameters for future<void>).
+     * \return ssts::future holding the result of f.
+     *
+     * The continuation runs on the thread that fulfils the promise (e.g. the ssts::task_pool worker that ran the task),
+     * or immediately on the calling thread if the result is already available.
+     * If the result holds an exception, f is not invoked and the exception is forwarded to the returned future.
+     * After this call valid() is false.
+     */
+    template<typename FunctionType>
+    auto then(FunctionType&& f)
+    {
+        using result_type = continuation_result_t<std::decay_t<FunctionType>>;
+
+        ssts::promise<result_type> p;
+        auto next = p.get_future();
+
+        auto state = std::move(_state);
+        auto* raw_state = state.get();
+
+        // The continuation is owned by the shared state, which is kept alive by the producer while it runs:
+        // a raw pointer is captured in order not to create an ownership cycle.
+        raw_state->set_continuation(ssts::task([raw_state, p = std::move(p), f = std::forward<FunctionType>(f)]() mutable
+        {
+            if (auto e = raw_state->exception())
+            {
+                p.set_exception(std::move(e));
+                return;
+            }
+
+            if constexpr (std::is_void_v<T>)
+                detail::set_promise_from(p, f);
+            else
+                detail::set_promise_from(p, f, std::move(raw_state->value()));
+        }));
+
+        return next;
+    }
+
+private:
+    friend class ssts::promise<T>;
+
+    template<typename FunctionType>
+    using continuation_result_t = typename std::conditional_t<std::is_void_v<T>,
+        std::invoke_result<FunctionType&>,
+        std::invoke_result<FunctionType&, detail::stored_type<T>&&>>::type;
+
+    explicit future(std::shared_ptr<detail::shared_state<T>> state)
+    : _state{ std::move(state) }
+    {
+    }
+
+    std::shared_ptr<detail::shared_state<T>> _state;
+};
+
+}
@@ -0,0 +1,203 @@
+/*!
+ * \file histogram.hpp
+ * \author Stefano Lusardi
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "clock.hpp"
+
+namespace ssts
+{
+/*! \struct latency_summary
+ *  \brief Summary of the durations recorded by one or more ssts::latency_histogram.
+ *
+ *  Percentiles are the upper bound of the histogram bucket they fall in (at most about 3% above the recorded value),
+ *  and never exceed the maximum.
+ */
+struct latency_summary
+{
+    /*! Number of recorded durations. */
+    uint64_t count = 0;
+
+    /*! Mean duration. */
+    ssts::clock::duration mean{ 0 };
+
+    /*! Median duration. */
+    ssts::clock::duration p50{ 0 };
+
+    /*! 99th percentile. */
+    ssts::clock::duration p99{ 0 };
+
+    /*! 99.9th percentile. */
+    ssts::clock::duration p999{ 0 };
+
+    /*! Maximum duration (exact). */
+    ssts::clock::duration max{ 0 };
+};
+
+/*! \class latency_histogram
+ *  \brief Log-linear (HDR style) histogram of durations, with a single writer and any number of readers.
+ *
+ *  Durations are recorded in nanoseconds: values below 32ns have their own bucket,
+ *  larger values are split in 32 linear sub-buckets per power of two (i.e. about 3% relative precision), up to 2^40ns (about 18 minutes).
+ *  Negative durations are recorded as zero, longer ones in the last bucket.
+ *
+ *  Recording is a handful of instructions and a relaxed store per counter: no read-modify-write atomic operation is involved,
+ *  hence each histogram must only be written by one thread at a time (e.g. one histogram per worker thread).
+ *  Readers can merge histograms concurrently, getting a consistent snapshot of each counter.
+ */
+class latency_histogram
+{
+    static constexpr unsigned sub_bucket_bits = 5;
+    static constexpr uint64_t sub_bucket_count = uint64_t{ 1 } << sub_bucket_bits;
+    static constexpr unsigned max_value_bits = 40;
+    static constexpr uint64_t max_value = (uint64_t{ 1 } << max_value_bits) - 1;
+
+public:
+    /*! Number of buckets. */
+    static constexpr size_t bucket_count = (max_value_bits - sub_bucket_bits + 1) * sub_bucket_count;
+
+    /*!
+     * \brief Record a duration.
+     * \param d Duration to record.
+     */
+    void record(ssts::clock::duration d) noexcept
+    {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+        const auto value = std::min(static_cast<uint64_t>(std::max<int64_t>(ns, 0)), max_value);
+
+        increment(_buckets[bucket_index(value)], 1);
+        increment(_count, 1);
+        increment(_sum, value);
+        if (value > _max.load(std::memory_order_relaxed))
+            _max.store(value, std::memory_order_relaxed);
+    }
+
+    /*!
+     * \brief Add the durations recorded by another histogram to this one.
+     * \param other Histogram to merge, that can be concurrently recorded to.
+     *
+     * This histogram must not be recorded to concurrently.
+     */
+    void merge(const latency_histogram& other) noexcept
+    {
+        for (size_t i = 0; i < bucket_count; ++i)
+            increment(_buckets[i], other._buckets[i].load(std::memory_order_relaxed));
+
+        increment(_count, other._count.load(std::memory_order_relaxed));
+        increment(_sum, other._sum.load(std::memory_order_relaxed));
+        _max.store(std::max(_max.load(std::memory_order_relaxed), other._max.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+    }
+
+    /*!
+     * \brief Get the number of recorded durations.
+     * \return Number of recorded durations.
+     */
+    uint64_t count() const noexcept { return _count.load(std::memory_order_relaxed); }
+
+    /*!
+     * \brief Get a percentile of the recorded durations.
+     * \param p Percentile, between 0 and 1 (e.g. 0.99).
+     * \return Upper bound of the bucket holding the percentile (zero if no duration has been recorded).
+     */
+    ssts::clock::duration percentile(double p) const noexcept
+    {
+        const auto max = _max.load(std::memory_order_relaxed);
+        uint64_t total = 0;
+        for (const auto& b : _buckets)
+            total += b.load(std::memory_order_relaxed);
+
+        if (total == 0)
+            return ssts::clock::duration{ 0 };
+
+        const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(p, 0.0, 1.0) * static_cast<double>(total))));
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < bucket_count; ++i)
+        {
+            cumulative += _buckets[i].load(std::memory_order_relaxed);
+            if (cumulative >= rank)
+                return to_duration(std::min(bucket_upper_bound(i), max));
+        }
+
+        return to_duration(max);
+    }
+
+    /*!
+     * \brief Summarize the recorded durations.
+     * \return ssts::latency_summary with count, mean, p50, p99, p99.9 and max.
+     */
+    latency_summary summary() const noexcept
+    {
+        latency_summary s;
+        s.count = count();
+        if (s.count == 0)
+            return s;
+
+        s.mean = to_duration(_sum.load(std::memory_order_relaxed) / s.count);
+        s.p50 = percentile(0.5);
+        s.p99 = percentile(0.99);
+        s.p999 = percentile(0.999);
+        s.max = to_duration(_max.load(std::memory_order_relaxed));
+        return s;
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, bucket_count> _buckets{};
+    std::atomic<uint64_t> _count{ 0 };
+    std::atomic<uint64_t> _sum{ 0 };
+    std::atomic<uint64_t> _max{ 0 };
+
+    // Single writer: a relaxed load and store is enough, and cheaper than fetch_add.
+    static void increment(std::atomic<uint64_t>& counter, uint64_t value) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    static unsigned highest_bit(uint64_t x) noexcept
+    {
+        unsigned n = 0;
+        #if defined(__GNUC__) || defined(__clang__)
+            n = 63u - static_cast<unsigned>(__builtin_clzll(x));
+        #else
+            while (x >>= 1) ++n;
+        #endif
+        return n;
+    }
+
+    // Values below sub_bucket_count are their own index. Larger values with highest bit h are in octave h - sub_bucket_bits + 1,
+    // and their sub-bucket is given by the sub_bucket_bits bits below h.
+    static size_t bucket_index(uint64_t value) noexcept
+    {
+        if (value < sub_bucket_count)
+            return static_cast<size_t>(value);
+
+        const auto h = highest_bit(value);
+        return static_cast<size_t>(((h - sub_bucket_bits + 1) << sub_bucket_bits) + ((value >> (h - sub_bucket_bits)) & (sub_bucket_count - 1)));
+    }
+
+    static uint64_t bucket_upper_bound(size_t index) noexcept
+    {
+        if (index < sub_bucket_count)
+            return index;
+
+        const auto octave = static_cast<unsigned>(index >> sub_bucket_bits);
+        const auto lower = (sub_bucket_count + (index & (sub_bucket_count - 1))) << (octave - 1);
+        return lower + (uint64_t{ 1 } << (octave - 1)) - 1;
+    }
+
+    static ssts::clock::duration to_duration(uint64_t ns) noexcept
+    {
+        return std::chrono::duration_cast<ssts::clock::duration>(std::chrono::nanoseconds(static_cast<int64_t>(ns)));
+    }
+};
+
+}
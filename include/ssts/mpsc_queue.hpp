@@ -0,0 +1,103 @@
+/*!
+ * \file mpsc_queue.hpp
+ * \author Stefano Lusardi
+ */
+
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace ssts
+{
+/*! \class mpsc_queue
+ *  \brief Unbounded multiple producers, single consumer FIFO queue.
+ *
+ *  Linked list queue with a stub node (D. Vyukov): push is a single atomic exchange followed by a store,
+ *  hence it is wait-free and never contends with the consumer.
+ *  pop must not be called concurrently (e.g. it is called by a single thread, or under a common lock),
+ *  while empty can be called by any thread at any time (e.g. to spin on the queue without taking the consumer lock).
+ *
+ *  \tparam T Type of the queued values.
+ */
+template<typename T>
+class mpsc_queue
+{
+    struct node
+    {
+        std::atomic<node*> next{ nullptr };
+        std::optional<T> value;
+    };
+
+public:
+    mpsc_queue()
+    : _head{ new node() }
+    , _tail{ _head.load() }
+    {
+    }
+
+    mpsc_queue(const mpsc_queue&) = delete;
+    mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+    ~mpsc_queue()
+    {
+        while (pop().has_value()) { }
+        delete _tail.load(std::memory_order_relaxed);
+    }
+
+    /*!
+     * \brief Push a value into the queue. Can be called concurrently by any thread.
+     * \param value Value to be moved into the queue.
+     */
+    void push(T&& value)
+    {
+        auto* n = new node();
+        n->value.emplace(std::move(value));
+
+        node* previous = _head.exchange(n, std::memory_order_seq_cst);
+        previous->next.store(n, std::memory_order_release);
+    }
+
+    /*!
+     * \brief Pop the oldest value. Consumer only.
+     * \return The oldest value, or std::nullopt if the queue is empty.
+     */
+    std::optional<T> pop()
+    {
+        node* tail = _tail.load(std::memory_order_relaxed);
+        node* next = tail->next.load(std::memory_order_acquire);
+        if (!next)
+        {
+            if (empty())
+                return std::nullopt;
+
+            // A producer has swapped the head but has not linked its node yet:
+            // it is only a couple of instructions away, unless it has been preempted.
+            while (!(next = tail->next.load(std::memory_order_acquire)))
+                std::this_thread::yield();
+        }
+
+        std::optional<T> value{ std::move(*next->value) };
+        next->value.reset();
+        _tail.store(next, std::memory_order_release);
+        delete tail;
+        return value;
+    }
+
+    /*!
+     * \brief Check if the queue is empty. Can be called concurrently by any thread.
+     * \return bool false if any push has been started and the value has not been popped yet.
+     *
+     * Only the consumer gets an exact result: for any other thread it may be outdated by a concurrent push or pop.
+     */
+    bool empty() const { return _head.load(std::memory_order_seq_cst) == _tail.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<node*> _head;
+    // Only written by the consumer, atomic so that empty() can be called concurrently with pop().
+    std::atomic<node*> _tail;
+};
+
+}
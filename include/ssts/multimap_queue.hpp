@@ -0,0 +1,92 @@
+/*!
+ * \file multimap_queue.hpp
+ * \author Stefano Lusardi
+ */
+
+#pragma once
+
+#include <iterator>
+#include <map>
+#include <vector>
+
+#include "clock.hpp"
+
+namespace ssts
+{
+/*! \class multimap_queue
+ *  \brief Timer queue based on std::multimap.
+ *
+ *  Default timer queue used by ssts::task_scheduler.
+ *  Every timer queue exposes the same interface, so that it can be selected as a policy of ssts::basic_task_scheduler:
+ *  - handle: identifies a queued value, stable until the value is erased or rescheduled.
+ *  - insert(), erase(), reschedule(): add, remove or move a value in time.
+ *    insert() can be given as hint the handle of a value whose time point is not later than the inserted one
+ *    (e.g. the previous value of a sorted sequence): queues that benefit from it insert in amortized O(1).
+ *  - next_time_point(): the time point at which the queue must be checked for due values.
+ *  - collect_due(): append the handles of all the values that are due at the given time point.
+ *    Collected values are still owned by the queue, and must be either erased or rescheduled.
+ *  - for_each_before(): call a function with the handle of each value whose time point is earlier than a limit,
+ *    in no particular order. The function returns the new limit, which must not be later than the current one:
+ *    values are visited until none is left before it (e.g. to compute a minimum over the earliest values).
+ *
+ *  Insert, erase and reschedule are O(log n), collect_due is O(k) where k is the number of due values.
+ *
+ *  \tparam T Type of the queued values.
+ */
+template<typename T>
+class multimap_queue
+{
+    using container_type = std::multimap<ssts::clock::time_point, T>;
+
+public:
+    using handle = typename container_type::iterator;
+
+    handle insert(const ssts::clock::time_point& timepoint, T&& value) { return _queue.emplace(timepoint, std::move(value)); }
+
+    handle insert(handle hint, const ssts::clock::time_point& timepoint, T&& value) { return _queue.emplace_hint(std::next(hint), timepoint, std::move(value)); }
+
+    void erase(handle h) { _queue.erase(h); }
+
+    handle reschedule(handle h, const ssts::clock::time_point& timepoint)
+    {
+        auto node = _queue.extract(h);
+        node.key() = timepoint;
+        return _queue.insert(std::move(node));
+    }
+
+    T& value(handle h) { return h->second; }
+    ssts::clock::time_point time_point(handle h) const { return h->first; }
+
+    bool empty() const { return _queue.empty(); }
+    size_t size() const { return _queue.size(); }
+    void clear() { _queue.clear(); }
+
+    ssts::clock::time_point next_time_point() const { return _queue.begin()->first; }
+
+    void collect_due(const ssts::clock::time_point& now, std::vector<handle>& due)
+    {
+        for (auto it = _queue.begin(); it != _queue.end() && it->first <= now; ++it)
+            due.push_back(it);
+    }
+
+    template<typename Function>
+    void for_each_before(ssts::clock::time_point limit, Function&& f)
+    {
+        for (auto it = _queue.begin(); it != _queue.end() && it->first < limit; ++it)
+            limit = f(it);
+    }
+
+private:
+    container_type _queue;
+};
+
+/*! \struct multimap_queue_policy
+ *  \brief ssts::basic_task_scheduler policy selecting ssts::multimap_queue.
+ */
+struct multimap_queue_policy
+{
+    template<typename T>
+    using queue_type = multimap_queue<T>;
+};
+
+}
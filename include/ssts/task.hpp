@@ -1,5 +1,5 @@
-/*! 
- * \file task.hpp 
+/*!
+ * \file task.hpp
  * \author Stefano Lusardi
  */
 
@@ -7,84 +7,199 @@
 
 #include <memory>
 #include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <new>
 #include <type_traits>
 
+/*! \def SSTS_TASK_INLINE_CAPACITY
+ *  \brief Size in bytes of the inline storage of ssts::task.
+ *
+ *  Callable objects that fit in this buffer are stored within the task itself, bigger ones are allocated on the heap.
+ *  The default value makes sizeof(ssts::task) equal to 64 bytes on 64 bit platforms.
+ */
+#ifndef SSTS_TASK_INLINE_CAPACITY
+#define SSTS_TASK_INLINE_CAPACITY 48
+#endif
 
 namespace ssts
 {
 
-/*! \class task
- *  \brief Move-only callable object.
+/*! \class basic_task
+ *  \brief Move-only callable object with inline storage.
  *
- *  This class represents a callable object. Can be initialized with any invocable type that supports operator().  
+ *  This class represents a callable object. Can be initialized with any invocable type that supports operator().
  *  Internally the class implements a type-erasure idiom to accept any callable signature without exposing it to the outside.
+ *  Callable objects up to InlineCapacity bytes (and nothrow move constructible) are stored in place,
+ *  larger ones fall back to a single heap allocation.
+ *  Type erasure is implemented with a pair of function pointers, no virtual dispatch is involved.
+ *
+ *  \tparam InlineCapacity Size in bytes of the inline storage.
  */
-class task
+template<std::size_t InlineCapacity>
+class basic_task
 {
+    static_assert(InlineCapacity >= sizeof(void*), "Inline storage must be able to hold at least a pointer");
+
 private:
-    struct task_base
+    enum class operation { move, destroy };
+
+    using invoke_fn = void(*)(void*);
+    using manage_fn = void(*)(operation, void*, void*);
+
+    template<typename FunctionType>
+    static constexpr bool is_inline_v = sizeof(FunctionType) <= InlineCapacity
+        && alignof(FunctionType) <= alignof(std::max_align_t)
+        && std::is_nothrow_move_constructible_v<FunctionType>;
+
+    template<typename FunctionType>
+    struct inline_ops
     {
-        virtual ~task_base() { }
-        virtual void invoke() = 0;
+        static void invoke(void* storage) { std::invoke(*std::launder(static_cast<FunctionType*>(storage))); }
+
+        static void manage(operation op, void* storage, void* other_storage)
+        {
+            auto* f = std::launder(static_cast<FunctionType*>(storage));
+            if (op == operation::move)
+                ::new (other_storage) FunctionType(std::move(*f));
+            f->~FunctionType();
+        }
     };
 
     template<typename FunctionType>
-    struct task_impl : task_base
+    struct heap_ops
     {
-        explicit task_impl(FunctionType&& f) 
-        : _func{ std::move(f) } 
-        { 
-            static_assert(std::is_invocable_v<decltype(f)>); 
+        static FunctionType*& get(void* storage) { return *std::launder(static_cast<FunctionType**>(storage)); }
+
+        static void invoke(void* storage) { std::invoke(*get(storage)); }
+
+        static void manage(operation op, void* storage, void* other_storage)
+        {
+            if (op == operation::move)
+                ::new (other_storage) FunctionType*(get(storage));
+            else
+                delete get(storage);
         }
-        void invoke() override { _func(); }
-        FunctionType _func;
     };
 
 public:
     /*!
      * \brief Default constructor.
      * \param f Callable parameterless object wrapped within this task instance.
-     * 
+     *
      * Creates a task instance with the given callable object.
      * The callable object can be e.g. a lambda function, a functor, a free function or a class method bound to an object.
      */
     template<typename FunctionType>
-    explicit task(FunctionType&& f) 
-    : _impl{ std::make_unique<task_impl<FunctionType>>(std::move(f)) } 
-    { }
-
-    task(task&) = delete;
-    task(const task&) = delete;
-    task& operator=(const task&) = delete;
-    
+    explicit basic_task(FunctionType&& f)
+    {
+        using function_type = std::decay_t<FunctionType>;
+        static_assert(std::is_invocable_v<function_type&>);
+
+        if constexpr (is_inline_v<function_type>)
+        {
+            ::new (static_cast<void*>(_storage)) function_type(std::forward<FunctionType>(f));
+            _invoke = &inline_ops<function_type>::invoke;
+            _manage = &inline_ops<function_type>::manage;
+        }
+        else
+        {
+            ::new (static_cast<void*>(_storage)) function_type*(new function_type(std::forward<FunctionType>(f)));
+            _invoke = &heap_ops<function_type>::invoke;
+            _manage = &heap_ops<function_type>::manage;
+        }
+    }
+
+    basic_task(basic_task&) = delete;
+    basic_task(const basic_task&) = delete;
+    basic_task& operator=(const basic_task&) = delete;
+
     /*!
      * \brief Move constructor.
      * \param other task object.
-     * 
+     *
      * Move constructs a task instance to this.
      */
-    task(task&& other) noexcept 
-    : _impl{ std::move(other._impl) } 
-    { }
-    
+    basic_task(basic_task&& other) noexcept
+    : _invoke{ other._invoke }
+    , _manage{ other._manage }
+    {
+        if (_manage)
+            _manage(operation::move, other._storage, _storage);
+
+        other._invoke = nullptr;
+        other._manage = nullptr;
+    }
+
+    /*!
+     * \brief Move assignment operator.
+     * \param other task object.
+     *
+     * Destroys the wrapped callable object, then moves the one of other into this.
+     */
+    basic_task& operator=(basic_task&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        if (_manage)
+            _manage(operation::destroy, _storage, nullptr);
+
+        _invoke = other._invoke;
+        _manage = other._manage;
+        if (_manage)
+            _manage(operation::move, other._storage, _storage);
+
+        other._invoke = nullptr;
+        other._manage = nullptr;
+        return *this;
+    }
+
+    /*!
+     * \brief Destructor.
+     *
+     * Destroys the wrapped callable object, releasing its heap storage if any.
+     */
+    ~basic_task()
+    {
+        if (_manage)
+            _manage(operation::destroy, _storage, nullptr);
+    }
+
     /*!
      * \brief operator().
-     * 
+     *
      * Invokes a task.
      */
-    void operator()() { _impl->invoke(); }
-    
+    void operator()() { _invoke(_storage); }
+
     /*!
      * \brief invoke().
-     * 
+     *
      * Invokes a task.
      * Explicit overload of operator().
      */
-    void invoke() { _impl->invoke(); }
+    void invoke() { _invoke(_storage); }
+
+    /*!
+     * \brief Check if a callable object type is stored inline.
+     * \tparam FunctionType Type of the callable object.
+     * \return bool indicating if a FunctionType object would be stored without heap allocations.
+     */
+    template<typename FunctionType>
+    static constexpr bool is_stored_inline() { return is_inline_v<std::decay_t<FunctionType>>; }
 
 private:
-    std::unique_ptr<task_base> _impl;
+    alignas(std::max_align_t) unsigned char _storage[InlineCapacity];
+    invoke_fn _invoke;
+    manage_fn _manage;
 };
 
-}
+/*! \typedef task
+ *  \brief ssts::basic_task with SSTS_TASK_INLINE_CAPACITY bytes of inline storage.
+ *
+ *  This is the task type used by ssts::task_pool and ssts::task_scheduler.
+ */
+using task = basic_task<SSTS_TASK_INLINE_CAPACITY>;
 
+}
@@ -5,7 +5,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <vector>
 #include <queue>
@@ -15,10 +20,188 @@
 #include <condition_variable>
 #include <unordered_set>
 
+#include "affinity.hpp"
+#include "clock.hpp"
 #include "task.hpp"
+#include "future.hpp"
+#include "histogram.hpp"
+#include "trace.hpp"
+#include "wait_strategy.hpp"
 
 namespace ssts
 {
+template<typename QueuePolicy> class basic_task_scheduler;
+
+/*! \enum pool_mode
+ *  \brief How an ssts::task_pool distributes tasks to its worker threads.
+ */
+enum class pool_mode
+{
+    shared_queue,   /*!< All workers pop tasks from a single queue. */
+    work_stealing   /*!< Each worker owns a deque: tasks pushed by a worker are run LIFO by that worker, idle workers steal FIFO from the others. */
+};
+
+/*! \enum queue_order
+ *  \brief Order in which an ssts::task_pool runs queued tasks of the same priority.
+ */
+enum class queue_order
+{
+    fifo,                   /*!< Tasks are run in the order they are queued. */
+    earliest_deadline_first /*!< The task with the earliest deadline (i.e. the most overdue one) is run first. */
+};
+
+/*! \enum priority
+ *  \brief Priority class of a task: queued tasks with higher priority are run first.
+ */
+enum class priority
+{
+    low,        /*!< Bulk work, run when no normal or high priority task is queued. */
+    normal,     /*!< Default priority. */
+    high        /*!< Latency critical work (e.g. heartbeats), run before any other queued task. */
+};
+
+/*! \struct worker_utilization
+ *  \brief Counters of one ssts::task_pool worker thread slot, see ssts::pool_stats.
+ */
+struct worker_utilization
+{
+    /*! Number of tasks run. */
+    uint64_t tasks_executed = 0;
+
+    /*! Time spent running tasks (with ssts::dispatch_mode::leader_follower, including the time spent as timer leader). */
+    ssts::clock::duration busy_time{ 0 };
+
+    /*! Time spent waiting for tasks (i.e. spinning, parked, or looking for a task to run). */
+    ssts::clock::duration idle_time{ 0 };
+
+    /*! Number of times the worker parked on the pool condition variable. */
+    uint64_t parks = 0;
+
+    /*! Number of parks that ended because a task was queued (as opposed to timeouts, spurious wake-ups and stop). */
+    uint64_t wakeups = 0;
+
+    /*! Whether a thread is currently running in this slot (threads of elastic pools retire when idle). */
+    bool is_running = false;
+};
+
+/*! \struct pool_stats
+ *  \brief Snapshot of the utilization of an ssts::task_pool, see ssts::task_pool::stats.
+ *
+ *  All the counters are cumulative since the pool has been created: the utilization over an interval
+ *  is given by the difference of two snapshots.
+ */
+struct pool_stats
+{
+    /*! Counters of each worker thread slot that has been used so far. */
+    std::vector<worker_utilization> workers;
+
+    /*! Number of tasks run by all the workers. */
+    uint64_t tasks_executed = 0;
+
+    /*! Time spent running tasks, summed over all the workers. */
+    ssts::clock::duration busy_time{ 0 };
+
+    /*! Time spent waiting for tasks, summed over all the workers. */
+    ssts::clock::duration idle_time{ 0 };
+
+    /*! Number of tasks queued when the snapshot has been taken. */
+    size_t queue_depth = 0;
+
+    /*! Mean number of tasks left in the queues, sampled each time a worker starts a task. */
+    double mean_queue_depth = 0.0;
+
+    /*! Maximum number of tasks left in the queues, sampled each time a worker starts a task. */
+    size_t max_queue_depth = 0;
+
+    /*! Mean time from queueing to start of the tasks. */
+    ssts::clock::duration mean_queue_wait{ 0 };
+
+    /*! Maximum time from queueing to start of the tasks. */
+    ssts::clock::duration max_queue_wait{ 0 };
+
+    /*!
+     * \brief Get the fraction of time the workers spent running tasks.
+     * \return busy_time / (busy_time + idle_time), between 0 and 1 (0 if no time has been recorded).
+     */
+    double utilization() const
+    {
+        const auto total = busy_time + idle_time;
+        return total.count() > 0 ? static_cast<double>(busy_time.count()) / static_cast<double>(total.count()) : 0.0;
+    }
+};
+
+/*! \struct pool_options
+ *  \brief Configuration of an ssts::task_pool.
+ */
+struct pool_options
+{
+    /*! Number of worker threads. Unlike the unsigned constructor, it is not clamped to std::thread::hardware_concurrency. */
+    unsigned int num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    /*! Task distribution mode. */
+    pool_mode mode = pool_mode::shared_queue;
+
+    /*! 
+     * Maximum number of worker threads. If greater than num_threads the pool is elastic: 
+     * num_threads is the minimum number of threads, and threads are added up to max_threads when tasks wait too long in the queue.
+     * Only pool_mode::shared_queue pools are elastic, work stealing pools always run num_threads threads.
+     */
+    unsigned int max_threads = 0;
+
+    /*! Elastic pools add a thread when no thread is idle and the oldest queued task has been waiting longer than this. */
+    ssts::clock::duration max_queue_wait = std::chrono::milliseconds(10);
+
+    /*! Elastic pools retire threads above num_threads that have been idle longer than this. */
+    ssts::clock::duration idle_timeout = std::chrono::seconds(10);
+
+    /*! 
+     * Starvation protection: a queued task that has been waiting longer than this is run before higher priority tasks.
+     * Within the same priority tasks are always run in FIFO order.
+     */
+    ssts::clock::duration starvation_timeout = std::chrono::milliseconds(100);
+
+    /*! 
+     * Order of the queued tasks of the same priority. The deadline of a task run by an ssts::basic_task_scheduler
+     * is its scheduled time point, tasks run directly on the pool are due when they are queued.
+     * In pool_mode::work_stealing pools it applies to the shared injection queue only.
+     */
+    queue_order order = queue_order::fifo;
+
+    /*! 
+     * Called by the worker thread right before running each task, with the task hash (std::hash of the task id, 0 if none)
+     * and the task lateness (i.e. start time minus deadline). Empty: lateness is not measured.
+     */
+    std::function<void(size_t task_hash, ssts::clock::duration lateness)> lateness_callback;
+
+    /*! 
+     * Record per worker histograms of the time from dispatch (i.e. queueing) to start, and from deadline to start, of each task.
+     * They cost a clock read per task, and are reported by ssts::basic_task_scheduler::stats.
+     */
+    bool lateness_stats = false;
+
+    /*!
+     * Record per worker utilization counters (tasks run, busy and idle time, parks and wake-ups)
+     * and sample the queue depth and the queue wait time, see ssts::task_pool::stats.
+     * They cost two clock reads per task, and a few counter updates without any read-modify-write atomic operation.
+     */
+    bool utilization_stats = false;
+
+    /*! Called every stats_interval with a ssts::pool_stats snapshot, from a dedicated thread. Setting it enables utilization_stats. */
+    std::function<void(const ssts::pool_stats&)> stats_callback;
+
+    /*! Period of stats_callback. */
+    ssts::clock::duration stats_interval = std::chrono::seconds(1);
+
+    /*! CPUs the workers are pinned to: worker i runs on worker_cpus[i % worker_cpus.size()]. Empty: workers are not pinned. */
+    std::vector<unsigned int> worker_cpus;
+
+    /*! NUMA node the workers are restricted to (any CPU of the node), used if worker_cpus is empty. See ssts::numa_node_cpus. */
+    std::optional<unsigned int> numa_node;
+
+    /*! How idle workers wait for new tasks. Default: park on a condition variable immediately. */
+    ssts::wait_strategy wait;
+};
+
 /*! \class task_pool
  *  \brief Task Pool that can run any callable object.
  *
@@ -35,20 +218,83 @@ public:
      * Creates a ssts::task_pool instance with the given number of threads.
      */
     explicit task_pool(const unsigned int num_threads = std::thread::hardware_concurrency())
+    : task_pool(clamped_options(num_threads))
+    {
+    }
+
+    /*!
+     * \brief Constructor.
+     * \param options Number of threads and task distribution mode.
+     * 
+     * Creates a ssts::task_pool instance with the given options.
+     */
+    explicit task_pool(const pool_options& options)
     : _is_running{ true }
     , _is_duplicate_allowed{ true }
+    , _mode{ options.mode }
+    , _min_threads{ std::max(options.num_threads, 1u) }
+    , _max_threads{ options.mode == pool_mode::shared_queue ? std::max(options.max_threads, _min_threads) : _min_threads }
+    , _max_queue_wait{ options.max_queue_wait }
+    , _idle_timeout{ options.idle_timeout }
+    , _starvation_timeout{ options.starvation_timeout }
+    , _lateness_callback{ options.lateness_callback }
+    , _is_recording_stats{ options.lateness_stats }
+    , _is_recording_utilization{ options.utilization_stats || options.stats_callback }
+    , _stats_callback{ options.stats_callback }
+    , _stats_interval{ options.stats_interval }
+    , _wait{ options.wait }
+    , _worker_cpus{ options.worker_cpus }
+    , _numa_node_cpus{ options.numa_node.has_value() ? ssts::numa_node_cpus(options.numa_node.value()) : std::vector<unsigned int>{} }
+    , _thread_count{ 0 }
+    , _task_queue{ options.order }
+    , _pending_tasks{ 0 }
+    , _idle_workers{ 0 }
+    , _injected_high_priority_tasks{ 0 }
+    , _initialized_workers{ 0 }
     {
-        const auto thread_count = std::clamp(num_threads, 1u, std::thread::hardware_concurrency());
-        _threads.reserve(thread_count);
+        const auto thread_count = _min_threads;
+
+        if (_is_recording_stats)
+            _worker_stats = std::make_unique<worker_stats[]>(_max_threads);
+
+        if (_is_recording_utilization)
+            _worker_counters = std::make_unique<worker_counters[]>(_max_threads);
+
+        // Work stealing workers allocate their own deque after being pinned, so that it is first touched (i.e. allocated)
+        // on their NUMA node: slots are filled by the workers, which wait for each other before stealing.
+        if (_mode == pool_mode::work_stealing)
+            _workers.resize(thread_count);
+
+        // Threads are only added or retired under _task_mtx, and slots are never released:
+        // reserving max_threads slots keeps stop() from racing with a reallocation.
+        _threads.reserve(_max_threads);
         try 
         {
             for (unsigned int i = 0; i < thread_count; ++i)
-                _threads.emplace_back(&task_pool::worker_thread, this);
+            {
+                if (_mode == pool_mode::work_stealing)
+                    _threads.emplace_back(&task_pool::work_stealing_thread, this, i);
+                else
+                    _threads.emplace_back(&task_pool::worker_thread, this, i);
+
+                ++_thread_count;
+            }
+
+            if (is_elastic())
+                _monitor_thread = std::thread(&task_pool::monitor_thread, this);
+
+            if (_stats_callback)
+                _stats_thread = std::thread(&task_pool::stats_thread, this);
+
+            if (_mode == pool_mode::work_stealing)
+            {
+                std::unique_lock lock(_task_mtx);
+                _task_cv.wait(lock, [this, thread_count] { return _initialized_workers == thread_count; });
+            }
         } 
         catch (...) 
         {
-            _is_running = false;
-            _task_cv.notify_all();
+            stop();
             throw;
         }
     }
@@ -84,6 +330,16 @@ public:
         }
         
         _task_cv.notify_all();
+        _monitor_cv.notify_all();
+
+        { std::scoped_lock lock(_stats_mtx); }
+        _stats_cv.notify_all();
+
+        if (_monitor_thread.joinable())
+            _monitor_thread.join();
+
+        if (_stats_thread.joinable())
+            _stats_thread.join();
 
         for (auto&& t : _threads)
         {
@@ -104,20 +360,107 @@ public:
      */
     template<typename FunctionType>
     auto run(FunctionType&& f, const std::optional<size_t>& task_hash = std::nullopt)
+    {
+        return run(ssts::priority::normal, std::forward<FunctionType>(f), task_hash);
+    }
+
+    /*!
+     * \brief Run a callable object asynchronously with the given priority.
+     * \tparam FunctionType Types of the callable object. 
+     * \param task_priority Task priority.
+     * \param f Callable object.
+     * \return std::future task result
+     * 
+     * Queued tasks with higher priority are run first, see ssts::pool_options::starvation_timeout.
+     */
+    template<typename FunctionType>
+    auto run(ssts::priority task_priority, FunctionType&& f, const std::optional<size_t>& task_hash = std::nullopt)
     {
         using result_type = std::invoke_result_t<std::decay_t<FunctionType>>;
         std::packaged_task<result_type()> task(std::forward<FunctionType>(f));
         std::future<result_type> future = task.get_future();
 
-        std::unique_lock lock(_task_mtx);
+        push_task(ssts::task(std::move(task)), task_hash, task_priority);
+        return future;
+    }
 
-        if(!_is_duplicate_allowed && is_already_running(task_hash))
-            return future;
+    /*!
+     * \brief Run a callable object asynchronously, discarding its result.
+     * \tparam FunctionType Types of the callable object. 
+     * \param f Callable object.
+     * 
+     * Enqueue a new task with the given callable object.
+     * Unlike ssts::task_pool::run, no std::packaged_task and no std::future shared state are created:
+     * callable objects that fit the ssts::task inline storage are enqueued without any allocation.
+     */
+    template<typename FunctionType>
+    void post(FunctionType&& f, const std::optional<size_t>& task_hash = std::nullopt)
+    {
+        push_task(ssts::task(std::forward<FunctionType>(f)), task_hash);
+    }
 
-        auto hash = task_hash.value_or(0);
-        _task_queue.emplace(hash, std::move(task));
-        lock.unlock();
-        _task_cv.notify_one();
+    /*!
+     * \brief Run a callable object asynchronously with the given priority, discarding its result.
+     * \param task_priority Task priority.
+     * \param f Callable object.
+     */
+    template<typename FunctionType>
+    void post(ssts::priority task_priority, FunctionType&& f, const std::optional<size_t>& task_hash = std::nullopt)
+    {
+        push_task(ssts::task(std::forward<FunctionType>(f)), task_hash, task_priority);
+    }
+
+    /*!
+     * \brief Run many callable objects asynchronously, discarding their results.
+     * \param first Iterator to the first callable object.
+     * \param last Iterator past the last callable object.
+     * 
+     * Callable objects are moved from the given range and enqueued taking the queue lock once:
+     * at most one idle worker per task is woken up.
+     */
+    template<typename InputIt>
+    void post_batch(InputIt first, InputIt last)
+    {
+        std::vector<batch_entry> tasks;
+        for (; first != last; ++first)
+            tasks.emplace_back(std::nullopt, ssts::task(std::move(*first)));
+
+        push_tasks(tasks);
+    }
+
+    /*!
+     * \brief Run a callable object asynchronously, returning an ssts::future.
+     * \tparam FunctionType Types of the callable object. 
+     * \param f Callable object.
+     * \return ssts::future task result
+     * 
+     * Enqueue a new task with the given callable object.
+     * Continuations attached to the returned ssts::future with ssts::future::then 
+     * run on the worker thread that executed the task, without blocking any other thread.
+     */
+    template<typename FunctionType>
+    auto submit(FunctionType&& f, const std::optional<size_t>& task_hash = std::nullopt)
+    {
+        return submit(ssts::priority::normal, std::forward<FunctionType>(f), task_hash);
+    }
+
+    /*!
+     * \brief Run a callable object asynchronously with the given priority, returning an ssts::future.
+     * \param task_priority Task priority.
+     * \param f Callable object.
+     * \return ssts::future task result
+     */
+    template<typename FunctionType>
+    auto submit(ssts::priority task_priority, FunctionType&& f, const std::optional<size_t>& task_hash = std::nullopt)
+    {
+        using result_type = std::invoke_result_t<std::decay_t<FunctionType>&>;
+        ssts::promise<result_type> p;
+        ssts::future<result_type> future = p.get_future();
+
+        push_task(ssts::task([p = std::move(p), f = std::forward<FunctionType>(f)]() mutable 
+        {
+            detail::set_promise_from(p, f);
+        }), task_hash, task_priority);
 
         return future;
     }
@@ -127,47 +470,1029 @@ public:
         _is_duplicate_allowed = is_allowed; 
     }
 
+    /*!
+     * \brief Get the task distribution mode.
+     * \return ssts::pool_mode of this pool.
+     */
+    pool_mode mode() const { return _mode; }
+
+    /*!
+     * \brief Get the number of running worker threads.
+     * \return Number of threads, between pool_options::num_threads and pool_options::max_threads for elastic pools.
+     */
+    unsigned int thread_count() const { return _thread_count.load(); }
+
+    /*!
+     * \brief Get a snapshot of the utilization of the workers.
+     * \return ssts::pool_stats with per worker and aggregated counters.
+     *
+     * Counters are only recorded if ssts::pool_options::utilization_stats (or ssts::pool_options::stats_callback) is set,
+     * otherwise only queue_depth is filled. Each worker updates its own counters without locks: 
+     * the snapshot is taken while they keep running, hence it is consistent per counter, not across counters.
+     */
+    ssts::pool_stats stats() const
+    {
+        ssts::pool_stats s;
+        s.queue_depth = _pending_tasks.load();
+        if (!_is_recording_utilization)
+            return s;
+
+        const auto now = ssts::clock::now();
+        uint64_t depth_samples = 0;
+        uint64_t depth_sum = 0;
+        uint64_t waits = 0;
+        ssts::clock::duration wait_sum{ 0 };
+        for (unsigned int slot = 0; slot < _max_threads; ++slot)
+        {
+            const auto& c = _worker_counters[slot];
+            if (!c.is_started.load(std::memory_order_acquire))
+                continue;
+
+            const auto w = c.snapshot(now);
+            s.tasks_executed += w.tasks_executed;
+            s.busy_time += w.busy_time;
+            s.idle_time += w.idle_time;
+            s.workers.push_back(w);
+
+            depth_samples += w.tasks_executed;
+            depth_sum += c.depth_sum.load(std::memory_order_relaxed);
+            s.max_queue_depth = std::max(s.max_queue_depth, static_cast<size_t>(c.depth_max.load(std::memory_order_relaxed)));
+            waits += c.waits.load(std::memory_order_relaxed);
+            wait_sum += ssts::clock::duration{ c.wait_sum.load(std::memory_order_relaxed) };
+            s.max_queue_wait = std::max(s.max_queue_wait, ssts::clock::duration{ c.wait_max.load(std::memory_order_relaxed) });
+        }
+
+        if (depth_samples > 0)
+            s.mean_queue_depth = static_cast<double>(depth_sum) / static_cast<double>(depth_samples);
+
+        if (waits > 0)
+            s.mean_queue_wait = wait_sum / waits;
+
+        return s;
+    }
+
 private:
+    template<typename QueuePolicy> friend class basic_task_scheduler;
+
+    // Tasks without an explicit deadline are due when they are queued.
+    // A default constructed enqueue_time means that the task was not timestamped (i.e. lateness is not reported).
+    // is_duplicate is set when the task is popped while a task with the same hash is running (see mark_running),
+    // is_tracked when its hash has been inserted into _active_hash_set instead: only then run_task erases it.
+    // is_duplicate_allowed exempts a single task from duplicate suppression (e.g. the replayed runs of ssts::missed_run_policy::burst).
+    struct queued_task
+    {
+        queued_task(std::optional<size_t> h, ssts::task&& t, ssts::clock::time_point enqueued = {}, std::optional<ssts::clock::time_point> due = std::nullopt, bool allow_duplicate = false)
+        : hash{ h }
+        , task{ std::move(t) }
+        , enqueue_time{ enqueued }
+        , deadline{ due.value_or(enqueued) }
+        , is_duplicate_allowed{ allow_duplicate }
+        {
+        }
+
+        std::optional<size_t> hash;
+        ssts::task task;
+        ssts::clock::time_point enqueue_time;
+        ssts::clock::time_point deadline;
+        bool is_duplicate_allowed;
+        bool is_duplicate = false;
+        bool is_tracked = false;
+    };
+
+    struct batch_entry
+    {
+        batch_entry(std::optional<size_t> h, ssts::task&& t, ssts::priority p = ssts::priority::normal, std::optional<ssts::clock::time_point> due = std::nullopt, bool allow_duplicate = false)
+        : hash{ h }
+        , task{ std::move(t) }
+        , task_priority{ p }
+        , deadline{ due }
+        , is_duplicate_allowed{ allow_duplicate }
+        {
+        }
+
+        std::optional<size_t> hash;
+        ssts::task task;
+        ssts::priority task_priority;
+        std::optional<ssts::clock::time_point> deadline;
+        bool is_duplicate_allowed;
+    };
+
+    static constexpr size_t priority_count = static_cast<size_t>(ssts::priority::high) + 1;
+
+    // Tasks of one priority class ordered by deadline, for queue_order::earliest_deadline_first.
+    // Tasks are kept in slots referenced both by a binary heap ordered by deadline and by a FIFO in queueing order
+    // (tasks are queued with _task_mtx held, so it is also enqueue_time order): the earliest deadline and the oldest task
+    // are found in O(1) and removed in O(log n). A removal through one index leaves a stale entry in the other one:
+    // stale entries are skipped once they reach the front, and purged when they outnumber the queued tasks (amortized O(1)).
+    class deadline_queue
+    {
+    public:
+        bool empty() const { return _size == 0; }
+        size_t size() const { return _size; }
+
+        template<typename... Args>
+        void emplace(Args&&... args)
+        {
+            size_t slot_index = _slots.size();
+            if (_free_slots.empty())
+            {
+                _slots.emplace_back();
+            }
+            else
+            {
+                slot_index = _free_slots.back();
+                _free_slots.pop_back();
+            }
+
+            auto& s = _slots[slot_index];
+            s.task.emplace(std::forward<Args>(args)...);
+            const entry e{ s.task->deadline, slot_index, ++s.generation };
+            _by_deadline.push_back(e);
+            std::push_heap(_by_deadline.begin(), _by_deadline.end(), later_deadline);
+            _by_age.push_back(e);
+            ++_size;
+        }
+
+        const queued_task& oldest() const { return *_slots[_by_age.front().slot].task; }
+
+        queued_task pop_earliest()
+        {
+            std::pop_heap(_by_deadline.begin(), _by_deadline.end(), later_deadline);
+            const auto e = _by_deadline.back();
+            _by_deadline.pop_back();
+            return take(e);
+        }
+
+        queued_task pop_oldest()
+        {
+            const auto e = _by_age.front();
+            _by_age.pop_front();
+            return take(e);
+        }
+
+    private:
+        struct slot
+        {
+            std::optional<queued_task> task;
+            uint64_t generation = 0;
+        };
+
+        // The deadline is copied into the entry: the heap order must not depend on a slot that may be reused.
+        struct entry
+        {
+            ssts::clock::time_point deadline;
+            size_t slot;
+            uint64_t generation;
+        };
+
+        std::vector<slot> _slots;
+        std::vector<size_t> _free_slots;
+        std::vector<entry> _by_deadline;
+        std::deque<entry> _by_age;
+        size_t _size = 0;
+
+        static bool later_deadline(const entry& a, const entry& b) { return a.deadline > b.deadline; }
+
+        bool is_stale(const entry& e) const { return !_slots[e.slot].task.has_value() || _slots[e.slot].generation != e.generation; }
+
+        queued_task take(const entry& e)
+        {
+            auto& s = _slots[e.slot];
+            queued_task task{ std::move(*s.task) };
+            s.task.reset();
+            _free_slots.push_back(e.slot);
+            --_size;
+
+            // Keep the front of both indices valid, so that oldest() and the next pop never skip entries.
+            while (!_by_deadline.empty() && is_stale(_by_deadline.front()))
+            {
+                std::pop_heap(_by_deadline.begin(), _by_deadline.end(), later_deadline);
+                _by_deadline.pop_back();
+            }
+
+            while (!_by_age.empty() && is_stale(_by_age.front()))
+                _by_age.pop_front();
+
+            auto is_stale_entry = [this](const entry& x) { return is_stale(x); };
+            if (_by_deadline.size() > 2 * _size + 16)
+            {
+                _by_deadline.erase(std::remove_if(_by_deadline.begin(), _by_deadline.end(), is_stale_entry), _by_deadline.end());
+                std::make_heap(_by_deadline.begin(), _by_deadline.end(), later_deadline);
+            }
+
+            if (_by_age.size() > 2 * _size + 16)
+                _by_age.erase(std::remove_if(_by_age.begin(), _by_age.end(), is_stale_entry), _by_age.end());
+
+            return task;
+        }
+    };
+
+    // Shared queue holding one FIFO (or one deadline_queue) per priority. Must be used with _task_mtx held.
+    class priority_queue
+    {
+    public:
+        explicit priority_queue(queue_order order) : _order{ order } { }
+
+        bool empty() const { return _size == 0; }
+        size_t size() const { return _size; }
+        size_t size(ssts::priority p) const { return size_at(index(p)); }
+
+        template<typename... Args>
+        void emplace(ssts::priority p, Args&&... args)
+        {
+            if (_order == queue_order::earliest_deadline_first)
+                _deadline_queues[index(p)].emplace(std::forward<Args>(args)...);
+            else
+                _queues[index(p)].emplace_back(std::forward<Args>(args)...);
+
+            ++_size;
+        }
+
+        // Pop the front of the highest priority non empty FIFO (or the earliest deadline of its deadline_queue), unless the oldest task
+        // of a lower priority one has been waiting longer than starvation_timeout: the oldest of those tasks is popped instead.
+        // The oldest task of each priority is found in O(1): the clock is only read, and at most priority_count queues are visited,
+        // when tasks with different priorities are queued.
+        queued_task pop(const ssts::clock::duration& starvation_timeout)
+        {
+            size_t highest = priority_count - 1;
+            while (size_at(highest) == 0)
+                --highest;
+
+            size_t selected = highest;
+            if (size_at(highest) < _size)
+            {
+                const auto now = ssts::clock::now();
+                auto selected_time = oldest_at(highest);
+                for (size_t i = 0; i < highest; ++i)
+                {
+                    if (size_at(i) == 0)
+                        continue;
+
+                    const auto enqueue_time = oldest_at(i);
+                    if (now - enqueue_time > starvation_timeout && enqueue_time < selected_time)
+                    {
+                        selected = i;
+                        selected_time = enqueue_time;
+                    }
+                }
+            }
+
+            --_size;
+            if (_order == queue_order::earliest_deadline_first)
+                return selected != highest ? _deadline_queues[selected].pop_oldest() : _deadline_queues[selected].pop_earliest();
+
+            queued_task task{ std::move(_queues[selected].front()) };
+            _queues[selected].pop_front();
+            return task;
+        }
+
+        ssts::clock::time_point oldest_enqueue_time() const
+        {
+            auto oldest_time = ssts::clock::time_point::max();
+            for (size_t i = 0; i < priority_count; ++i)
+                if (size_at(i) > 0)
+                    oldest_time = std::min(oldest_time, oldest_at(i));
+
+            return oldest_time;
+        }
+
+    private:
+        const queue_order _order;
+        std::array<std::deque<queued_task>, priority_count> _queues;
+        std::array<deadline_queue, priority_count> _deadline_queues;
+        size_t _size = 0;
+
+        size_t size_at(size_t i) const 
+        { 
+            return _order == queue_order::earliest_deadline_first ? _deadline_queues[i].size() : _queues[i].size(); 
+        }
+
+        // The front of a FIFO is its oldest task, a deadline_queue keeps track of its own.
+        ssts::clock::time_point oldest_at(size_t i) const
+        {
+            return _order == queue_order::earliest_deadline_first ? _deadline_queues[i].oldest().enqueue_time : _queues[i].front().enqueue_time;
+        }
+
+        static size_t index(ssts::priority p) { return static_cast<size_t>(p); }
+    };
+
+    static constexpr size_t max_injected_batch_size = 32;
+
+    // Work stealing deque: the owner pushes and pops at the back, thieves pop at the front.
+    // Its mutex is only contended when a thief steals from it.
+    struct worker
+    {
+        std::mutex mtx;
+        std::deque<queued_task> tasks;
+    };
+
+    // Lateness histograms, one per worker slot: each one is only written by the worker thread that owns the slot.
+    struct alignas(64) worker_stats
+    {
+        ssts::latency_histogram dispatch_to_start;
+        ssts::latency_histogram scheduled_to_start;
+    };
+
+    // Utilization counters, one per worker slot: each one is only written by the worker thread that owns the slot,
+    // with relaxed loads and stores (see ssts::latency_histogram).
+    struct alignas(64) worker_counters
+    {
+        std::atomic<uint64_t> tasks_executed{ 0 };
+        std::atomic<uint64_t> parks{ 0 };
+        std::atomic<uint64_t> wakeups{ 0 };
+        std::atomic<uint64_t> depth_sum{ 0 };
+        std::atomic<uint64_t> depth_max{ 0 };
+        std::atomic<uint64_t> waits{ 0 };
+        std::atomic<ssts::clock::rep> wait_sum{ 0 };
+        std::atomic<ssts::clock::rep> wait_max{ 0 };
+        std::atomic<ssts::clock::rep> busy_time{ 0 };
+        std::atomic<ssts::clock::rep> idle_time{ 0 };
+        // Start of the current busy or idle period.
+        std::atomic<ssts::clock::rep> state_since{ 0 };
+        std::atomic_bool is_busy{ false };
+        std::atomic_bool is_running{ false };
+        std::atomic_bool is_started{ false };
+        // Tasks run from within a task (e.g. by the ssts::basic_task_scheduler timer leader) only count as one busy period.
+        unsigned int nesting = 0;
+
+        template<typename T>
+        static void add(std::atomic<T>& counter, T value) { counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed); }
+
+        template<typename T>
+        static void set_max(std::atomic<T>& counter, T value) 
+        { 
+            if (value > counter.load(std::memory_order_relaxed)) 
+                counter.store(value, std::memory_order_relaxed); 
+        }
+
+        // Add the time elapsed since the current period started to busy_time or idle_time, and start a new period.
+        void switch_state(ssts::clock::time_point now, bool busy)
+        {
+            const auto since = state_since.load(std::memory_order_relaxed);
+            add(is_busy.load(std::memory_order_relaxed) ? busy_time : idle_time, now.time_since_epoch().count() - since);
+            state_since.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+            is_busy.store(busy, std::memory_order_relaxed);
+        }
+
+        void start_thread()
+        {
+            state_since.store(ssts::clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+            is_busy.store(false, std::memory_order_relaxed);
+            is_running.store(true, std::memory_order_relaxed);
+            is_started.store(true, std::memory_order_release);
+        }
+
+        void stop_thread()
+        {
+            switch_state(ssts::clock::now(), false);
+            is_running.store(false, std::memory_order_relaxed);
+        }
+
+        void start_task(ssts::clock::time_point now, ssts::clock::time_point enqueue_time, size_t queue_depth)
+        {
+            if (nesting++ == 0)
+                switch_state(now, true);
+
+            add<uint64_t>(depth_sum, queue_depth);
+            set_max<uint64_t>(depth_max, queue_depth);
+
+            if (enqueue_time != ssts::clock::time_point{})
+            {
+                const auto wait = (now - enqueue_time).count();
+                add<uint64_t>(waits, 1);
+                add(wait_sum, wait);
+                set_max(wait_max, wait);
+            }
+        }
+
+        void end_task(ssts::clock::time_point now)
+        {
+            if (--nesting == 0)
+                switch_state(now, false);
+
+            add<uint64_t>(tasks_executed, 1);
+        }
+
+        void count_park(bool is_woken_by_task)
+        {
+            add<uint64_t>(parks, 1);
+            if (is_woken_by_task)
+                add<uint64_t>(wakeups, 1);
+        }
+
+        // The current period of a running thread is added to its busy or idle time.
+        worker_utilization snapshot(ssts::clock::time_point now) const
+        {
+            worker_utilization w;
+            w.tasks_executed = tasks_executed.load(std::memory_order_relaxed);
+            w.busy_time = ssts::clock::duration{ busy_time.load(std::memory_order_relaxed) };
+            w.idle_time = ssts::clock::duration{ idle_time.load(std::memory_order_relaxed) };
+            w.parks = parks.load(std::memory_order_relaxed);
+            w.wakeups = wakeups.load(std::memory_order_relaxed);
+            w.is_running = is_running.load(std::memory_order_relaxed);
+
+            if (w.is_running)
+            {
+                const auto current = std::max(ssts::clock::duration{ now.time_since_epoch().count() - state_since.load(std::memory_order_relaxed) }, ssts::clock::duration{ 0 });
+                (is_busy.load(std::memory_order_relaxed) ? w.busy_time : w.idle_time) += current;
+            }
+
+            return w;
+        }
+    };
+
     std::atomic_bool _is_running;
     std::atomic_bool _is_duplicate_allowed;
+    const pool_mode _mode;
+    const unsigned int _min_threads;
+    const unsigned int _max_threads;
+    const ssts::clock::duration _max_queue_wait;
+    const ssts::clock::duration _idle_timeout;
+    const ssts::clock::duration _starvation_timeout;
+    const std::function<void(size_t, ssts::clock::duration)> _lateness_callback;
+    const bool _is_recording_stats;
+    std::unique_ptr<worker_stats[]> _worker_stats;
+    const bool _is_recording_utilization;
+    std::unique_ptr<worker_counters[]> _worker_counters;
+    const std::function<void(const ssts::pool_stats&)> _stats_callback;
+    const ssts::clock::duration _stats_interval;
+    std::thread _stats_thread;
+    std::condition_variable _stats_cv;
+    std::mutex _stats_mtx;
+    const ssts::wait_strategy _wait;
+    const std::vector<unsigned int> _worker_cpus;
+    const std::vector<unsigned int> _numa_node_cpus;
+    std::atomic_uint _thread_count;
     std::vector<std::thread> _threads;
-    std::queue<std::pair<size_t, ssts::task>> _task_queue;
+    std::vector<size_t> _retired_slots;
+    std::thread _monitor_thread;
+    std::condition_variable _monitor_cv;
+    bool _is_monitor_idle = false;
+    priority_queue _task_queue;
+    std::vector<std::unique_ptr<worker>> _workers;
+    // Number of queued tasks in any queue, polled without locks by spinning and parking workers.
+    std::atomic_size_t _pending_tasks;
+    std::atomic_uint _idle_workers;
+    std::atomic_size_t _injected_high_priority_tasks;
+    unsigned int _initialized_workers;
     std::unordered_set<size_t> _active_hash_set;
     std::condition_variable _task_cv;
     std::mutex _task_mtx;
     std::mutex _hash_mtx;
 
-    void worker_thread()
+    // Worker of the calling thread, when the calling thread belongs to a work stealing pool.
+    static inline thread_local std::pair<const task_pool*, worker*> _local_worker{ nullptr, nullptr };
+
+    // Lateness histograms of the calling thread, when the calling thread is a worker of a pool recording them.
+    static inline thread_local std::pair<const task_pool*, worker_stats*> _local_stats{ nullptr, nullptr };
+
+    // Utilization counters of the calling thread, when the calling thread is a worker of a pool recording them.
+    static inline thread_local std::pair<const task_pool*, worker_counters*> _local_counters{ nullptr, nullptr };
+
+    void pin_worker(size_t slot) const
     {
+        if (!_worker_cpus.empty())
+            ssts::set_thread_affinity({ _worker_cpus[slot % _worker_cpus.size()] });
+        else if (!_numa_node_cpus.empty())
+            ssts::set_thread_affinity(_numa_node_cpus);
+    }
+
+    void worker_thread(size_t slot)
+    {
+        pin_worker(slot);
+        SSTS_TRACE_THREAD_NAME("ssts worker " + std::to_string(slot));
+        if (_is_recording_stats)
+            _local_stats = { this, &_worker_stats[slot] };
+
+        start_counters(slot);
+
         while (_is_running)
         {
             std::unique_lock lock(_task_mtx);
-            _task_cv.wait(lock, [this] { return !_task_queue.empty() || !_is_running; });
+            if (_task_queue.empty() && _is_running && _wait.is_spinning())
+            {
+                lock.unlock();
+                ssts::spin_wait(_wait, [this] { return _pending_tasks.load() > 0 || !_is_running; });
+                lock.lock();
+            }
+
+            if (_task_queue.empty() && _is_running)
+            {
+                auto has_task = [this] { return !_task_queue.empty() || !_is_running; };
+                bool is_woken = true;
+
+                _idle_workers.fetch_add(1);
+                if (is_elastic())
+                    is_woken = _task_cv.wait_for(lock, _idle_timeout, has_task);
+                else
+                    _task_cv.wait(lock, has_task);
+                _idle_workers.fetch_sub(1);
+                count_park(!_task_queue.empty());
+
+                // Threads above the minimum retire after idle_timeout. 
+                // Their slot is joined and reused by the next thread that is added.
+                if (!is_woken && _thread_count > _min_threads)
+                {
+                    stop_counters();
+                    _thread_count.fetch_sub(1);
+                    _retired_slots.push_back(slot);
+                    return;
+                }
+            }
 
             if (!_is_running)
-                return;
+                break;
+
+            if (_task_queue.empty())
+                continue;
+
+            auto task = _task_queue.pop(_starvation_timeout);
+            _pending_tasks.fetch_sub(1);
+            mark_running(task);
+
+            lock.unlock();
+            run_task(task);
+        }
+
+        stop_counters();
+    }
+
+    // Options of the unsigned constructor: a shared queue pool, with num_threads clamped to std::thread::hardware_concurrency.
+    static pool_options clamped_options(unsigned int num_threads)
+    {
+        pool_options options;
+        options.num_threads = std::clamp(num_threads, 1u, std::max(1u, std::thread::hardware_concurrency()));
+        options.mode = pool_mode::shared_queue;
+        return options;
+    }
+
+    bool is_elastic() const { return _max_threads > _min_threads; }
+
+    // Elastic pools only: sleeps while idle threads can take all the queued tasks (or the pool is at max_threads),
+    // otherwise wakes up when the oldest queued task reaches max_queue_wait, and adds a thread
+    // if it is still queued (e.g. running tasks are blocked on I/O).
+    void monitor_thread()
+    {
+        std::unique_lock lock(_task_mtx);
+        while (_is_running)
+        {
+            if (!is_backlogged() || _thread_count >= _max_threads)
+            {
+                _is_monitor_idle = true;
+                _monitor_cv.wait(lock);
+                _is_monitor_idle = false;
+                continue;
+            }
+
+            const auto deadline = _task_queue.oldest_enqueue_time() + _max_queue_wait;
+            if (ssts::clock::now() < deadline)
+            {
+                _monitor_cv.wait_until(lock, deadline);
+                continue;
+            }
+
+            add_thread();
+
+            // Give the new thread the time to pick up the oldest task before checking again.
+            _monitor_cv.wait_for(lock, _max_queue_wait);
+        }
+    }
+
+    // Must be called with _task_mtx held.
+    bool is_backlogged() const { return _task_queue.size() > _idle_workers; }
+
+    // Must be called with _task_mtx held.
+    void notify_monitor()
+    {
+        if (is_elastic() && _is_monitor_idle && is_backlogged())
+            _monitor_cv.notify_one();
+    }
+
+    // Must be called with _task_mtx held.
+    void add_thread()
+    {
+        if (_retired_slots.empty())
+        {
+            _threads.emplace_back(&task_pool::worker_thread, this, _threads.size());
+        }
+        else
+        {
+            const auto slot = _retired_slots.back();
+            _retired_slots.pop_back();
+            _threads[slot].join();
+            _threads[slot] = std::thread(&task_pool::worker_thread, this, slot);
+        }
+
+        _thread_count.fetch_add(1);
+    }
+
+    void work_stealing_thread(size_t index)
+    {
+        pin_worker(index);
+        SSTS_TRACE_THREAD_NAME("ssts worker " + std::to_string(index));
+
+        {
+            std::unique_lock lock(_task_mtx);
+            _workers[index] = std::make_unique<worker>();
+            ++_initialized_workers;
+            _task_cv.notify_all();
+            _task_cv.wait(lock, [this] { return _initialized_workers == _workers.size() || !_is_running; });
+        }
+
+        _local_worker = { this, _workers[index].get() };
+        if (_is_recording_stats)
+            _local_stats = { this, &_worker_stats[index] };
+
+        start_counters(index);
+
+        while (_is_running)
+        {
+            // High priority tasks are always pushed to the injection queue: they are taken before local ones.
+            if (_injected_high_priority_tasks.load() > 0)
+            {
+                if (auto task = pop_injected(index))
+                {
+                    run_task(*task);
+                    continue;
+                }
+            }
+
+            if (auto task = pop_local(index))
+            {
+                run_task(*task);
+                continue;
+            }
+
+            if (auto task = pop_injected(index))
+            {
+                run_task(*task);
+                continue;
+            }
+
+            if (auto task = steal(index))
+            {
+                run_task(*task);
+                continue;
+            }
+
+            if (ssts::spin_wait(_wait, [this] { return _pending_tasks.load() > 0 || !_is_running; }))
+                continue;
+
+            // Park until a task is pushed. _idle_workers is incremented before _pending_tasks is checked,
+            // while push_task increments _pending_tasks before checking _idle_workers: 
+            // either this worker sees the new task, or the pusher sees this worker idle and notifies it under _task_mtx.
+            std::unique_lock lock(_task_mtx);
+            _idle_workers.fetch_add(1);
+            _task_cv.wait(lock, [this] { return _pending_tasks.load() > 0 || !_is_running; });
+            _idle_workers.fetch_sub(1);
+            count_park(_pending_tasks.load() > 0);
+        }
+
+        stop_counters();
+    }
+
+    std::optional<queued_task> pop_local(size_t index)
+    {
+        auto& w = *_workers[index];
+        std::scoped_lock lock(w.mtx);
+        if (w.tasks.empty())
+            return std::nullopt;
+
+        std::optional<queued_task> task{ std::move(w.tasks.back()) };
+        w.tasks.pop_back();
+        _pending_tasks.fetch_sub(1);
+        mark_running(*task);
+        return task;
+    }
+
+    // Take the oldest injected task, and move a fair share of the following ones into the local deque
+    // so that the injection queue lock is not taken for every task.
+    // They are pushed at the front of the (empty) local deque: LIFO local pops run them in injection order.
+    std::optional<queued_task> pop_injected(size_t index)
+    {
+        std::scoped_lock lock(_task_mtx);
+        if (_task_queue.empty())
+            return std::nullopt;
+
+        std::optional<queued_task> task{ _task_queue.pop(_starvation_timeout) };
+        _pending_tasks.fetch_sub(1);
+        mark_running(*task);
+
+        // High priority tasks are not moved into the local deque, where they could wait behind a running task.
+        const auto batch_size = _task_queue.size(ssts::priority::high) > 0 ? 0 : std::min(_task_queue.size() / _workers.size(), max_injected_batch_size);
+        if (batch_size > 0)
+        {
+            auto& w = *_workers[index];
+            std::scoped_lock local_lock(w.mtx);
+            for (size_t n = 0; n < batch_size; ++n)
+                w.tasks.emplace_front(_task_queue.pop(_starvation_timeout));
+        }
+
+        _injected_high_priority_tasks.store(_task_queue.size(ssts::priority::high));
+        return task;
+    }
+
+    std::optional<queued_task> steal(size_t thief_index)
+    {
+        for (size_t i = 1; i < _workers.size(); ++i)
+        {
+            auto& victim = *_workers[(thief_index + i) % _workers.size()];
+            std::unique_lock lock(victim.mtx, std::try_to_lock);
+            if (!lock.owns_lock() || victim.tasks.empty())
+                continue;
 
-            auto task = std::move(_task_queue.front().second);
-            auto hash = _task_queue.front().first;
+            std::optional<queued_task> task{ std::move(victim.tasks.front()) };
+            victim.tasks.pop_front();
+            _pending_tasks.fetch_sub(1);
+            mark_running(*task);
+            return task;
+        }
 
-            if(!_is_duplicate_allowed)
+        return std::nullopt;
+    }
+
+    // Tasks pushed to a local deque are only timestamped if their lateness or queue wait time is recorded.
+    ssts::clock::time_point local_enqueue_time() const 
+    { 
+        return _lateness_callback || _is_recording_stats || _is_recording_utilization ? ssts::clock::now() : ssts::clock::time_point{}; 
+    }
+
+    // Must be called in the same critical section that removes the task from its queue (or deque):
+    // a task is then always either queued or running for is_already_running().
+    // Tasks with the same hash can still be queued together (only running ones are checked when a task is pushed):
+    // if a task with the same hash is already running, the popped task is marked as a duplicate and run_task drops it.
+    void mark_running(queued_task& task)
+    {
+        if(_is_duplicate_allowed || task.is_duplicate_allowed || !task.hash.has_value())
+            return;
+
+        std::scoped_lock hash_lock(_hash_mtx);
+        task.is_tracked = _active_hash_set.insert(task.hash.value()).second;
+        task.is_duplicate = !task.is_tracked;
+    }
+
+    // The task must have been marked as running (see mark_running).
+    // It is called without any queue lock held: a dropped duplicate is destroyed outside of them.
+    void run_task(queued_task& task)
+    {
+        if (task.is_duplicate)
+            return;
+
+        const auto hash = task.hash.value_or(0);
+        const auto [counters_pool, counters] = _local_counters;
+        const bool is_counted = counters_pool == this;
+        const bool is_lateness_recorded = (_lateness_callback || _is_recording_stats) && task.deadline != ssts::clock::time_point{};
+        const auto now = is_lateness_recorded || is_counted ? ssts::clock::now() : ssts::clock::time_point{};
+
+        if (is_counted)
+            counters->start_task(now, task.enqueue_time, _pending_tasks.load(std::memory_order_relaxed));
+
+        if (is_lateness_recorded)
+        {
+            if (_lateness_callback)
+                _lateness_callback(hash, now - task.deadline);
+
+            if (auto [pool, stats] = _local_stats; pool == this)
             {
-                std::scoped_lock hash_lock(_hash_mtx);
-                _active_hash_set.insert(hash);
+                stats->dispatch_to_start.record(now - task.enqueue_time);
+                stats->scheduled_to_start.record(now - task.deadline);
             }
+        }
+
+        SSTS_TRACE(start, hash);
+        task.task();
+        SSTS_TRACE(end, hash);
 
-            _task_queue.pop();
+        if (is_counted)
+            counters->end_task(ssts::clock::now());
 
+        // The flag set by mark_running is checked rather than _is_duplicate_allowed, which may have changed while the task was running.
+        if(task.is_tracked)
+        {
+            std::scoped_lock hash_lock(_hash_mtx);
+            _active_hash_set.erase(task.hash.value());
+        }
+    }
+
+    // Run a task on the calling thread, as a worker would run it once popped.
+    void run_inline(batch_entry&& entry)
+    {
+        queued_task task{ entry.hash, std::move(entry.task), local_enqueue_time(), entry.deadline, entry.is_duplicate_allowed };
+        mark_running(task);
+        run_task(task);
+    }
+
+    // Pop and run one queued task on the calling thread, which must be a worker of this pool.
+    // Used by the ssts::basic_task_scheduler timer leader (see ssts::dispatch_mode) when no other worker is idle.
+    bool run_pending_task()
+    {
+        std::optional<queued_task> task;
+        if (_mode == pool_mode::shared_queue)
+        {
+            std::scoped_lock lock(_task_mtx);
+            if (!_task_queue.empty())
+            {
+                task.emplace(_task_queue.pop(_starvation_timeout));
+                _pending_tasks.fetch_sub(1);
+                mark_running(*task);
+            }
+        }
+        else if (auto [pool, local] = _local_worker; pool == this)
+        {
+            const auto index = static_cast<size_t>(std::find_if(_workers.begin(), _workers.end(), [local = local](const auto& w) { return w.get() == local; }) - _workers.begin());
+            if (_injected_high_priority_tasks.load() > 0)
+                task = pop_injected(index);
+            if (!task)
+                task = pop_local(index);
+            if (!task)
+                task = pop_injected(index);
+            if (!task)
+                task = steal(index);
+        }
+
+        if (!task)
+            return false;
+
+        run_task(*task);
+        return true;
+    }
+
+    // Merge the lateness histograms of all the workers (see pool_options::lateness_stats).
+    void merge_stats(ssts::latency_histogram& dispatch_to_start, ssts::latency_histogram& scheduled_to_start) const
+    {
+        if (!_is_recording_stats)
+            return;
+
+        for (unsigned int slot = 0; slot < _max_threads; ++slot)
+        {
+            dispatch_to_start.merge(_worker_stats[slot].dispatch_to_start);
+            scheduled_to_start.merge(_worker_stats[slot].scheduled_to_start);
+        }
+    }
+
+    void start_counters(size_t slot)
+    {
+        if (!_is_recording_utilization)
+            return;
+
+        _local_counters = { this, &_worker_counters[slot] };
+        _worker_counters[slot].start_thread();
+    }
+
+    void stop_counters()
+    {
+        if (auto [pool, counters] = _local_counters; pool == this)
+        {
+            counters->stop_thread();
+            _local_counters = { nullptr, nullptr };
+        }
+    }
+
+    void count_park(bool is_woken_by_task)
+    {
+        if (auto [pool, counters] = _local_counters; pool == this)
+            counters->count_park(is_woken_by_task);
+    }
+
+    void stats_thread()
+    {
+        std::unique_lock lock(_stats_mtx);
+        while (!_stats_cv.wait_for(lock, _stats_interval, [this] { return !_is_running; }))
+        {
             lock.unlock();
-            task();
+            _stats_callback(stats());
+            lock.lock();
+        }
+    }
+
+    // Check if queued tasks are waiting while no worker is parked to take them.
+    bool is_saturated() const { return _pending_tasks.load() > 0 && _idle_workers.load() == 0; }
+
+    void push_task(ssts::task&& t, const std::optional<size_t>& task_hash, ssts::priority task_priority = ssts::priority::normal)
+    {
+        if (_mode == pool_mode::work_stealing)
+        {
+            if(!_is_duplicate_allowed && is_already_running(task_hash))
+                return;
+
+            // _pending_tasks is incremented before the task becomes visible, so that it never underflows when the task is popped.
+            _pending_tasks.fetch_add(1);
+
+            // Normal priority tasks pushed by a worker of this pool go to its own deque, 
+            // any other thread (or priority) uses the injection queue.
+            if (auto [pool, local] = _local_worker; pool == this && task_priority == ssts::priority::normal)
+            {
+                std::scoped_lock lock(local->mtx);
+                local->tasks.emplace_back(task_hash, std::move(t), local_enqueue_time());
+                SSTS_TRACE(enqueue, task_hash.value_or(0));
+            }
+            else
+            {
+                std::scoped_lock lock(_task_mtx);
+                _task_queue.emplace(task_priority, task_hash, std::move(t), ssts::clock::now());
+                _injected_high_priority_tasks.store(_task_queue.size(ssts::priority::high));
+                SSTS_TRACE(enqueue, task_hash.value_or(0));
+            }
+
+            if (_idle_workers.load() > 0)
+            {
+                { std::scoped_lock lock(_task_mtx); }
+                _task_cv.notify_one();
+            }
+
+            return;
+        }
+
+        std::unique_lock lock(_task_mtx);
+
+        if(!_is_duplicate_allowed && is_already_running(task_hash))
+            return;
+
+        _task_queue.emplace(task_priority, task_hash, std::move(t), ssts::clock::now());
+        _pending_tasks.fetch_add(1);
+        SSTS_TRACE(enqueue, task_hash.value_or(0));
+        notify_monitor();
+        lock.unlock();
+        _task_cv.notify_one();
+    }
+
+    // Push all the given tasks taking the queue lock once, then wake up to one idle worker per task.
+    // Tasks are moved from, and the vector is cleared (its capacity is kept for the next batch).
+    void push_tasks(std::vector<batch_entry>& tasks)
+    {
+        auto emplace_all = [this, &tasks](auto&& emplace)
+        {
+            size_t count = 0;
+            for (auto& entry : tasks)
+            {
+                if(!_is_duplicate_allowed && !entry.is_duplicate_allowed && is_already_running(entry.hash))
+                    continue;
+
+                emplace(entry);
+                SSTS_TRACE(enqueue, entry.hash.value_or(0));
+                ++count;
+            }
+            return count;
+        };
+
+        size_t pushed_count = 0;
+        unsigned idle_count = 0;
+
+        if (_mode == pool_mode::work_stealing)
+        {
+            const bool is_normal_priority = std::all_of(tasks.begin(), tasks.end(), [](const batch_entry& e) { return e.task_priority == ssts::priority::normal; });
+
+            // _pending_tasks is incremented before the lock is released, i.e. before any task can be popped.
+            if (auto [pool, local] = _local_worker; pool == this && is_normal_priority)
+            {
+                std::scoped_lock lock(local->mtx);
+                const auto now = local_enqueue_time();
+                pushed_count = emplace_all([local = local, &now](batch_entry& e) { local->tasks.emplace_back(e.hash, std::move(e.task), now, e.deadline, e.is_duplicate_allowed); });
+                _pending_tasks.fetch_add(pushed_count);
+            }
+            else
+            {
+                std::scoped_lock lock(_task_mtx);
+                const auto now = ssts::clock::now();
+                pushed_count = emplace_all([this, &now](batch_entry& e) { _task_queue.emplace(e.task_priority, e.hash, std::move(e.task), now, e.deadline, e.is_duplicate_allowed); });
+                _pending_tasks.fetch_add(pushed_count);
+                _injected_high_priority_tasks.store(_task_queue.size(ssts::priority::high));
+            }
 
-            if(!_is_duplicate_allowed)
+            // As in push_task: a parking worker is either already waiting, or it will see _pending_tasks.
+            idle_count = _idle_workers.load();
+            if (idle_count > 0)
             {
-                std::scoped_lock hash_lock(_hash_mtx);
-                if (_active_hash_set.find(hash) != _active_hash_set.end())
-                    _active_hash_set.erase(hash);
+                std::scoped_lock lock(_task_mtx);
             }
         }
+        else
+        {
+            std::scoped_lock lock(_task_mtx);
+            const auto now = ssts::clock::now();
+            pushed_count = emplace_all([this, &now](batch_entry& e) { _task_queue.emplace(e.task_priority, e.hash, std::move(e.task), now, e.deadline, e.is_duplicate_allowed); });
+            _pending_tasks.fetch_add(pushed_count);
+            idle_count = _idle_workers.load();
+            notify_monitor();
+        }
+
+        tasks.clear();
+        notify_workers(pushed_count, idle_count);
+    }
+
+    void notify_workers(size_t task_count, unsigned idle_count)
+    {
+        if (task_count == 0 || idle_count == 0)
+            return;
+
+        if (task_count >= idle_count)
+        {
+            _task_cv.notify_all();
+            return;
+        }
+
+        for (size_t n = 0; n < task_count; ++n)
+            _task_cv.notify_one();
     }
 
     bool is_already_running(const std::optional<size_t>& opt_hash)
@@ -5,42 +5,260 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <future>
-#include <map>
 #include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <optional>
 #include <string>
 #include <functional>
+#include <memory>
 
+#include "clock.hpp"
 #include "task.hpp"
 #include "task_pool.hpp"
+#include "timer_backend.hpp"
+#include "trace.hpp"
+#include "future.hpp"
+#include "mpsc_queue.hpp"
+#include "multimap_queue.hpp"
+#include "dary_heap_queue.hpp"
+#include "timing_wheel_queue.hpp"
 
 using namespace std::chrono_literals;
 using namespace std::string_literals;
 
 namespace ssts
 {
-/*! \typedef clock Alias for std::chrono::steady_clock.
- */
-using clock = std::chrono::steady_clock;
-
 /*! ssts library version.  
  *  \return std::string current ssts version.  
 */ 
 inline std::string version() { return "Task Scheduler v1.0.0"; }
 
-/*! \class task_scheduler
+/*! \enum dispatch_mode
+ *  \brief Which thread waits for the next task time point and hands due tasks over to the ssts::task_pool.
+ */
+enum class dispatch_mode
+{
+    scheduler_thread, /*!< A dedicated scheduler thread pushes due tasks to the pool workers (default). */
+    leader_follower   /*!< No scheduler thread: one pool worker at a time (the leader) waits for the next time point. 
+                           When tasks are due it promotes another worker to leader, and runs the first due task itself. */
+};
+
+/*! \enum missed_run_policy
+ *  \brief What a recursive task does when it falls behind, i.e. when more than one interval has elapsed since its time point once it is due.
+ */
+enum class missed_run_policy
+{
+    skip,       /*!< Run once for the due time point, drop the missed runs and keep the original time grid (default). */
+    run_once,   /*!< Run once for the due time point and all the missed runs, then restart the interval from the time of that run. */
+    burst       /*!< Run once for the due time point, then replay the latest missed runs back to back (up to a maximum burst), keeping the original time grid.
+                     Replayed runs are never dropped as duplicates, even if duplicates are not allowed: they may overlap with each other. */
+};
+
+/*! \struct scheduler_options
+ *  \brief Configuration of an ssts::basic_task_scheduler.
+ */
+struct scheduler_options
+{
+    /*! Options of the underlying ssts::task_pool. */
+    ssts::pool_options pool;
+
+    /*! CPUs the scheduler thread is allowed to run on (e.g. ssts::numa_node_cpus). Empty: the scheduler thread is not pinned. */
+    std::vector<unsigned int> scheduler_cpus;
+
+    /*! 
+     * How the scheduler thread waits for the next time point: it parks until spin_duration + yield_duration before it,
+     * then yields and spins until the time point is reached. Default: park until the time point.
+     */
+    ssts::wait_strategy wait;
+
+    /*! How the scheduler thread sleeps until the next time point. ssts::timer_backend::timerfd is only available on Linux. */
+    ssts::timer_backend timer = ssts::timer_backend::condition_variable;
+
+    /*!
+     * Default timer slack: how late a task is allowed to start after its time point.
+     * The scheduler thread wakes up at the earliest time point plus slack among all tasks,
+     * and dispatches every task due by then in a single batch. Default: no slack.
+     * It can be overridden per task by ssts::basic_task_scheduler::set_slack.
+     */
+    ssts::clock::duration timer_slack{ 0 };
+
+    /*!
+     * How due tasks reach the ssts::task_pool workers. With ssts::dispatch_mode::leader_follower
+     * one worker is busy waiting for the next time point while the scheduler is idle, and scheduler_cpus is ignored.
+     */
+    ssts::dispatch_mode dispatch = ssts::dispatch_mode::scheduler_thread;
+
+    /*!
+     * Record execution metrics of the tasks that have a task_id, see ssts::basic_task_scheduler::metrics.
+     * Each run of such a task costs two clock reads and two thread CPU time reads.
+     */
+    bool per_task_metrics = false;
+
+    /*!
+     * Maximum number of task_ids that are no longer scheduled (e.g. one-shot tasks that have been dispatched)
+     * whose metrics are kept, see ssts::basic_task_scheduler::metrics. The least recently retired are dropped first.
+     */
+    size_t max_retired_metrics = 1024;
+
+    /*! Default policy of the recursive tasks that fall behind. It can be overridden per task by ssts::basic_task_scheduler::set_missed_run_policy. */
+    ssts::missed_run_policy missed_runs = ssts::missed_run_policy::skip;
+
+    /*! Maximum number of missed runs replayed at once with ssts::missed_run_policy::burst. */
+    size_t max_burst = 10;
+};
+
+/*! \struct scheduler_stats
+ *  \brief Snapshot of the lateness of the tasks run by an ssts::basic_task_scheduler, see ssts::basic_task_scheduler::stats.
+ */
+struct scheduler_stats
+{
+    /*! From the scheduled time point to the dispatch of the task to the ssts::task_pool (i.e. timer wake-up lateness). */
+    ssts::latency_summary scheduled_to_dispatch;
+
+    /*! From the dispatch to the start of the task on a worker thread (i.e. pool queueing delay). */
+    ssts::latency_summary dispatch_to_start;
+
+    /*! From the scheduled time point to the start of the task (i.e. total lateness). */
+    ssts::latency_summary scheduled_to_start;
+};
+
+/*! \struct task_metrics
+ *  \brief Snapshot of the execution metrics of the tasks scheduled with a given task_id, see ssts::basic_task_scheduler::metrics.
+ */
+struct task_metrics
+{
+    /*! Number of completed runs. */
+    uint64_t runs = 0;
+
+    /*! Wall clock time spent running the task, summed over all the runs. */
+    ssts::clock::duration total_time{ 0 };
+
+    /*! Longest run. */
+    ssts::clock::duration max_time{ 0 };
+
+    /*! CPU time consumed by the worker threads while running the task (zero where ssts::thread_cpu_time is not available). */
+    std::chrono::nanoseconds cpu_time{ 0 };
+
+    /*! Start of the last run. */
+    ssts::clock::time_point last_start;
+
+    /*! End of the last run. */
+    ssts::clock::time_point last_end;
+
+    /*! Number of runs of a recursive task that took longer than its interval. */
+    uint64_t overruns = 0;
+};
+
+/*! \struct batch_task
+ *  \brief Task description used to schedule many tasks at once with ssts::basic_task_scheduler::post_batch.
+ */
+struct batch_task
+{
+    /*!
+     * \brief Constructor.
+     * \param tp Time point at which the task is run.
+     * \param f Callable object.
+     * \param id Optional task identifier.
+     * \param every Optional interval of a recursive task.
+     * \param p Task priority.
+     */
+    template<typename FunctionType>
+    batch_task(ssts::clock::time_point tp, FunctionType&& f, std::optional<std::string> id = std::nullopt, std::optional<ssts::clock::duration> every = std::nullopt, ssts::priority p = ssts::priority::normal)
+    : timepoint{ tp }
+    , task{ std::forward<FunctionType>(f) }
+    , task_id{ std::move(id) }
+    , interval{ every }
+    , task_priority{ p }
+    {
+    }
+
+    /*! Time point at which the task is run (first run for recursive tasks). */
+    ssts::clock::time_point timepoint;
+
+    /*! Callable object. Its result is discarded. */
+    ssts::task task;
+
+    /*! Optional task identifier. */
+    std::optional<std::string> task_id;
+
+    /*! Optional interval: if set the task is recursive, as if started with ssts::basic_task_scheduler::every. */
+    std::optional<ssts::clock::duration> interval;
+
+    /*! Priority of the task in the ssts::task_pool queue once it is due. */
+    ssts::priority task_priority;
+};
+
+/*! \class basic_task_scheduler
  *  \brief Task Scheduler that can launch tasks on based several time-based policies.
  *
  *  This class is used to manage a queue of tasks using a fixed number of threads.  
  *  The actual task execution is delgated to an internal ssts::task_pool object.
+ *  The data structure that keeps tasks sorted by time is selected by QueuePolicy:
+ *  ssts::multimap_queue_policy (default), ssts::dary_heap_queue_policy or ssts::timing_wheel_queue_policy.
+ *
+ *  \tparam QueuePolicy Timer queue policy.
  */
-class task_scheduler
+template<typename QueuePolicy = ssts::multimap_queue_policy>
+class basic_task_scheduler
 {
 private:
+    // Execution metrics shared by the scheduled tasks with the same task_id, updated by the worker threads that run them.
+    struct task_counters
+    {
+        std::atomic<uint64_t> runs{ 0 };
+        std::atomic<uint64_t> overruns{ 0 };
+        std::atomic<ssts::clock::rep> total_time{ 0 };
+        std::atomic<ssts::clock::rep> max_time{ 0 };
+        std::atomic<std::chrono::nanoseconds::rep> cpu_time{ 0 };
+        std::atomic<ssts::clock::rep> last_start{ 0 };
+        std::atomic<ssts::clock::rep> last_end{ 0 };
+        std::atomic<ssts::clock::rep> interval{ 0 };
+
+        void run(ssts::task& t)
+        {
+            const auto start = ssts::clock::now();
+            const auto cpu_start = ssts::thread_cpu_time();
+            t.invoke();
+            const auto cpu_end = ssts::thread_cpu_time();
+            const auto end = ssts::clock::now();
+
+            const auto elapsed = (end - start).count();
+            total_time.fetch_add(elapsed, std::memory_order_relaxed);
+            cpu_time.fetch_add((cpu_end - cpu_start).count(), std::memory_order_relaxed);
+            
+            auto max = max_time.load(std::memory_order_relaxed);
+            while (elapsed > max && !max_time.compare_exchange_weak(max, elapsed, std::memory_order_relaxed)) { }
+
+            const auto task_interval = interval.load(std::memory_order_relaxed);
+            if (task_interval > 0 && elapsed > task_interval)
+                overruns.fetch_add(1, std::memory_order_relaxed);
+
+            last_start.store(start.time_since_epoch().count(), std::memory_order_relaxed);
+            last_end.store(end.time_since_epoch().count(), std::memory_order_relaxed);
+            runs.fetch_add(1, std::memory_order_release);
+        }
+
+        ssts::task_metrics snapshot() const
+        {
+            ssts::task_metrics m;
+            m.runs = runs.load(std::memory_order_acquire);
+            m.total_time = ssts::clock::duration{ total_time.load(std::memory_order_relaxed) };
+            m.max_time = ssts::clock::duration{ max_time.load(std::memory_order_relaxed) };
+            m.cpu_time = std::chrono::nanoseconds{ cpu_time.load(std::memory_order_relaxed) };
+            m.last_start = ssts::clock::time_point{ ssts::clock::duration{ last_start.load(std::memory_order_relaxed) } };
+            m.last_end = ssts::clock::time_point{ ssts::clock::duration{ last_end.load(std::memory_order_relaxed) } };
+            m.overruns = overruns.load(std::memory_order_relaxed);
+            return m;
+        }
+    };
+
     class schedulable_task
     {
     public:
@@ -76,6 +294,14 @@ private:
         {
         }
 
+        explicit schedulable_task(ssts::task&& t, std::optional<size_t> hash, std::optional<ssts::clock::duration> interval) 
+        : _task{std::make_shared<ssts::task>(std::move(t))}
+        , _is_enabled{true}
+        , _interval{interval}
+        , _hash{hash}
+        {
+        }
+
         ~schedulable_task() { }
 
         schedulable_task(schedulable_task&) = delete;
@@ -88,36 +314,87 @@ private:
         , _is_enabled{std::move(other._is_enabled)}
         , _interval{std::move(other._interval)}
         , _hash{std::move(other._hash)}
+        , _priority{other._priority}
+        , _slack{other._slack}
+        , _metrics{std::move(other._metrics)}
+        , _missed_run_policy{other._missed_run_policy}
+        , _missed_runs{other._missed_runs}
         {
         }
 
         void invoke() { _task->invoke(); }
 
-        std::shared_ptr<schedulable_task> clone() { return std::shared_ptr<schedulable_task>(new schedulable_task(this)); }
+        // Both share() and release() return an ssts::task that only holds the shared pointers to the wrapped task
+        // and to its metrics, which fit the ssts::task inline storage: handing a task over to the ssts::task_pool never allocates.
+        ssts::task share() const 
+        { 
+            if (_metrics)
+                return ssts::task([t = _task, m = _metrics] { m->run(*t); });
+
+            return ssts::task([t = _task] { t->invoke(); }); 
+        }
+
+        ssts::task release() 
+        { 
+            if (_metrics)
+                return ssts::task([t = std::move(_task), m = std::move(_metrics)] { m->run(*t); });
+
+            return ssts::task([t = std::move(_task)] { t->invoke(); }); 
+        }
 
         void set_enabled(bool is_enabled) { _is_enabled = is_enabled; }
         bool is_enabled() const { return _is_enabled; }
         
-        void set_interval(ssts::clock::duration interval) { _interval = interval; }
+        void set_interval(ssts::clock::duration interval) 
+        { 
+            _interval = interval; 
+            if (_metrics)
+                _metrics->interval.store(interval.count(), std::memory_order_relaxed);
+        }
         std::optional<ssts::clock::duration> interval() const { return _interval; }
         
         std::optional<size_t> hash() const { return _hash; }
 
+        void set_priority(ssts::priority p) { _priority = p; }
+        ssts::priority priority() const { return _priority; }
+
+        void set_slack(ssts::clock::duration slack) { _slack = slack; }
+        std::optional<ssts::clock::duration> slack() const { return _slack; }
+
+        void set_missed_run_policy(ssts::missed_run_policy policy, size_t max_burst) { _missed_run_policy = std::make_pair(policy, max_burst); }
+        std::optional<std::pair<ssts::missed_run_policy, size_t>> missed_run_policy() const { return _missed_run_policy; }
+
+        void add_missed_runs(uint64_t count) { _missed_runs += count; }
+        uint64_t missed_runs() const { return _missed_runs; }
+
+        void set_metrics(std::shared_ptr<task_counters> metrics)
+        {
+            _metrics = std::move(metrics);
+            if (_interval.has_value())
+                _metrics->interval.store(_interval->count(), std::memory_order_relaxed);
+        }
+
     private:
         std::shared_ptr<ssts::task> _task;
         bool _is_enabled;
         std::optional<ssts::clock::duration> _interval;
         std::optional<size_t> _hash;
+        ssts::priority _priority = ssts::priority::normal;
+        std::optional<ssts::clock::duration> _slack;
+        std::shared_ptr<task_counters> _metrics;
+        std::optional<std::pair<ssts::missed_run_policy, size_t>> _missed_run_policy;
+        uint64_t _missed_runs = 0;
+    };
 
-        schedulable_task(schedulable_task* st) 
-        : _task{st->_task}
-        , _is_enabled{st->_is_enabled}
-        , _interval{st->_interval}
-        , _hash{st->_hash}
-        {
-        }
+    struct submitted_task
+    {
+        ssts::clock::time_point timepoint;
+        schedulable_task task;
     };
 
+    using queue_type = typename QueuePolicy::template queue_type<schedulable_task>;
+    using task_handle = typename queue_type::handle;
+
 public:
     /*!
      * \brief Constructor.
@@ -126,26 +403,67 @@ public:
      * Creates a ssts::task_scheduler instance. 
      * The number of threads to be used by the ssts::task_pool defaults to the number of threads supported by the platform.
      */
-    explicit task_scheduler(const unsigned int num_threads = std::thread::hardware_concurrency())
+    explicit basic_task_scheduler(const unsigned int num_threads = std::thread::hardware_concurrency())
     : _tp{num_threads}
     , _is_running{true}
     , _is_duplicate_allowed{ true }
+    , _timer_slack{ 0 }
+    , _has_slack{ false }
+    , _dispatch{ ssts::dispatch_mode::scheduler_thread }
+    , _is_recording_metrics{ false }
+    , _max_retired_metrics{ 1024 }
+    , _missed_run_policy{ ssts::missed_run_policy::skip, 10 }
+    , _next_task_timepoint{ ssts::clock::time_point::max() }
+    {
+    }
+
+    /*!
+     * \brief Constructor.
+     * \param options Options of the underlying ssts::task_pool (e.g. number of threads and ssts::pool_mode).
+     * 
+     * Creates a ssts::task_scheduler instance whose tasks are run by a ssts::task_pool with the given options.
+     */
+    explicit basic_task_scheduler(const ssts::pool_options& options)
+    : basic_task_scheduler(make_scheduler_options(options))
+    {
+    }
+
+    /*!
+     * \brief Constructor.
+     * \param options Options of the scheduler thread and of the underlying ssts::task_pool.
+     * 
+     * Creates a ssts::task_scheduler instance with the given options.
+     */
+    explicit basic_task_scheduler(const ssts::scheduler_options& options)
+    : _tp{options.pool}
+    , _is_running{true}
+    , _is_duplicate_allowed{ true }
+    , _scheduler_cpus{ options.scheduler_cpus }
+    , _wait{ options.wait }
+    , _timer{ options.timer == ssts::timer_backend::timerfd && ssts::timerfd_timer::is_supported() ? std::make_unique<ssts::timerfd_timer>() : nullptr }
+    , _timer_slack{ options.timer_slack }
+    , _has_slack{ options.timer_slack.count() > 0 }
+    , _dispatch{ options.dispatch }
+    , _is_recording_metrics{ options.per_task_metrics }
+    , _max_retired_metrics{ options.max_retired_metrics }
+    , _missed_run_policy{ options.missed_runs, options.max_burst }
+    , _next_task_timepoint{ ssts::clock::time_point::max() }
     {
     }
 
-    task_scheduler(task_scheduler&) = delete;
-    task_scheduler(const task_scheduler&) = delete;
-    task_scheduler& operator=(const task_scheduler&) = delete;
+    basic_task_scheduler(basic_task_scheduler&) = delete;
+    basic_task_scheduler(const basic_task_scheduler&) = delete;
+    basic_task_scheduler& operator=(const basic_task_scheduler&) = delete;
 
-    task_scheduler(task_scheduler&&) noexcept = delete;
-    task_scheduler& operator=(task_scheduler&&) = delete;
+    basic_task_scheduler(basic_task_scheduler&&) noexcept = delete;
+    basic_task_scheduler& operator=(basic_task_scheduler&&) = delete;
 
     /*!
      * \brief Destructor.
      * 
      * Destructs this. If the task_scheduler is running its tasks are stopped first.
      */
-    ~task_scheduler()
+    ~basic_task_scheduler()
     {
         if (_is_running)
             stop();
@@ -156,39 +474,35 @@ public:
      *
      * This function starts the task_scheduler worker thread.
      * The function is guaranteed to return after the scheduler thread is started.
+     * With ssts::dispatch_mode::leader_follower no thread is started: the first leader is handed over to the ssts::task_pool.
      */
     void start()
     {
+        if (_dispatch == ssts::dispatch_mode::leader_follower)
+        {
+            add_leader_task();
+            _tp.push_tasks(_dispatch_tasks);
+            return;
+        }
+
         std::promise<void> thread_started_notifier;
         std::future<void> thread_started_watcher = thread_started_notifier.get_future();
 
         _scheduler_thread = std::thread([this, &thread_started_notifier] 
         {
+            ssts::set_thread_affinity(_scheduler_cpus);
+            SSTS_TRACE_THREAD_NAME("ssts scheduler");
             thread_started_notifier.set_value();
 
             while (_is_running)
             {
                 std::unique_lock lock(_update_tasks_mtx);
+                if (!wait_for_due_tasks(lock))
+                    continue;
 
-                if (_tasks.empty())
-                {
-                    _update_tasks_cv.wait(lock, [this]{ return !_is_running || !_tasks.empty(); });
-                }
-                else
-                {
-                    // If the last enqueued task is the first to be scheduled _next_task_timepoint must be updated to its timepoint.
-                    // Check if the condition variable _update_tasks_cv is triggered because of a timeout (i.e. _next_task_timepoint has just been reached),
-                    // or because of a new notification (i.e. a new task has been enqueued and the condition variable is notified): 
-                    // in case of a timeout proceed with update_tasks(), otherwise continue.
-                    _next_task_timepoint = _tasks.begin()->first;
-                    if (_update_tasks_cv.wait_until(lock, _next_task_timepoint.load()) == std::cv_status::no_timeout)
-                        continue;
-                }
-
-                if (!_is_running)
-                    return;
-
-                update_tasks();
+                // Due tasks are handed over to the ssts::task_pool in a single batch, after _update_tasks_mtx is released.
+                lock.unlock();
+                _tp.push_tasks(_dispatch_tasks);
             }
         });
 
@@ -204,6 +518,7 @@ public:
     size_t size()
     {
         std::scoped_lock lock(_update_tasks_mtx);
+        drain_submissions();
         return _tasks.size();
     }
 
@@ -219,11 +534,15 @@ public:
             _is_running = false;
         }
 
-        _update_tasks_cv.notify_all();
+        notify_scheduler();
         
         {
             std::scoped_lock lock(_update_tasks_mtx);
+            while (_submissions.pop().has_value()) { }
             _tasks.clear();
+            _task_index.clear();
+            _task_metrics.clear();
+            _retired_metrics.clear();
         }
 
         if (_scheduler_thread.joinable())
@@ -271,8 +590,9 @@ public:
     bool is_scheduled(const std::string& task_id)
     { 
         std::scoped_lock lock(_update_tasks_mtx);
+        drain_submissions();
 
-        return get_task_iterator(task_id) != _tasks.end();
+        return find_task(task_id).has_value();
     }
 
     /*!
@@ -288,9 +608,10 @@ public:
     bool is_enabled(const std::string& task_id)
     { 
         std::scoped_lock lock(_update_tasks_mtx);
+        drain_submissions();
 
-        if (auto task = get_task_iterator(task_id); task != _tasks.end())
-            return task->second.is_enabled();
+        if (auto task = find_task(task_id))
+            return _tasks.value(*task).is_enabled();
         
         return false;
     }
@@ -308,10 +629,12 @@ public:
     bool set_enabled(const std::string& task_id, bool is_enabled) 
     {
         std::scoped_lock lock(_update_tasks_mtx);
+        drain_submissions();
 
-        if (auto task = get_task_iterator(task_id); task != _tasks.end())
+        if (auto task = find_task(task_id))
         {
-            task->second.set_enabled(is_enabled);
+            SSTS_TRACE(update, _hasher(task_id));
+            _tasks.value(*task).set_enabled(is_enabled);
             return true;
         }
         
@@ -330,10 +653,15 @@ public:
     bool remove_task(const std::string& task_id) 
     {
         std::scoped_lock lock(_update_tasks_mtx);
+        drain_submissions();
 
-        if (auto task = get_task_iterator(task_id); task != _tasks.end())
+        if (auto task = find_task(task_id))
         {
-            _tasks.erase(task);
+            SSTS_TRACE(remove, _hasher(task_id));
+            erase_task(*task);
+            if (!already_exists(_hasher(task_id)))
+                _task_metrics.erase(_hasher(task_id));
+
             return true;
         }
         
@@ -353,47 +681,199 @@ public:
     bool update_interval(const std::string& task_id, ssts::clock::duration interval) 
     {
         std::unique_lock lock(_update_tasks_mtx);
+        drain_submissions();
 
-        if (auto task_iterator = get_task_iterator(task_id); task_iterator != _tasks.end() && task_iterator->second.interval().has_value())
+        if (auto task = find_task(task_id); task.has_value() && _tasks.value(*task).interval().has_value())
         {
-            const auto task_interval = task_iterator->second.interval().value();
-            auto task_next_start_time = task_iterator->first - task_interval;
+            auto& st = _tasks.value(*task);
+            const auto task_interval = st.interval().value();
+            const auto task_next_start_time = first_slot_not_before(_tasks.time_point(*task) - task_interval, interval, ssts::clock::now()).first;
 
-            const auto now = ssts::clock::now();
-            while(now > task_next_start_time)
-                task_next_start_time += interval;
-
-            task_iterator->second.set_interval(interval);
-            _tasks.emplace(std::move(task_next_start_time), std::move(task_iterator->second));
-            _tasks.erase(task_iterator);
+            SSTS_TRACE(update, _hasher(task_id));
+            st.set_interval(interval);
+            reschedule_task(*task, task_next_start_time);
             lock.unlock();
             
-            _update_tasks_cv.notify_one();
+            notify_scheduler();
             return true;
         }
         
         return false;
     }
 
+    /*!
+     * \brief Set the timer slack of a task.
+     * \param task_id task_id to update.
+     * \param slack how late the task is allowed to start after its time point.
+     * \return bool indicating if the task has been properly updated.
+     *
+     * The slack overrides ssts::scheduler_options::timer_slack for the given task:
+     * its deadlines can be coalesced with the ones of other tasks into a single wake-up of the scheduler thread.
+     * If a task has been started without a task_id it is not possible to update it.
+     * In case a task_id is not found this function return false.
+     */
+    bool set_slack(const std::string& task_id, ssts::clock::duration slack)
+    {
+        std::unique_lock lock(_update_tasks_mtx);
+        drain_submissions();
+
+        if (auto task = find_task(task_id))
+        {
+            SSTS_TRACE(update, _hasher(task_id));
+            _tasks.value(*task).set_slack(slack);
+            _has_slack = true;
+            lock.unlock();
+
+            notify_scheduler();
+            return true;
+        }
+
+        return false;
+    }
+
+    /*!
+     * \brief Set what a recursive task does when it falls behind.
+     * \param task_id task_id to update.
+     * \param policy ssts::missed_run_policy of the task.
+     * \param max_burst Maximum number of missed runs replayed at once with ssts::missed_run_policy::burst.
+     * \return bool indicating if the task has been properly updated.
+     *
+     * The policy overrides ssts::scheduler_options::missed_runs for the given task.
+     * If a task is not recursive or has not been assigned a task_id, it is not possible to update it.
+     * In case of any failure (task_id not found or task non recursive) this function return false.
+     */
+    bool set_missed_run_policy(const std::string& task_id, ssts::missed_run_policy policy, size_t max_burst = 10)
+    {
+        std::scoped_lock lock(_update_tasks_mtx);
+        drain_submissions();
+
+        if (auto task = find_task(task_id); task.has_value() && _tasks.value(*task).interval().has_value())
+        {
+            SSTS_TRACE(update, _hasher(task_id));
+            _tasks.value(*task).set_missed_run_policy(policy, max_burst);
+            return true;
+        }
+
+        return false;
+    }
+
+    /*!
+     * \brief Get the number of missed runs of a recursive task.
+     * \param task_id task_id to query.
+     * \return Number of time points of the task that elapsed while it was waiting to be dispatched (whatever its ssts::missed_run_policy),
+     * std::nullopt if the task_id is not found.
+     */
+    std::optional<uint64_t> missed_runs(const std::string& task_id)
+    {
+        std::scoped_lock lock(_update_tasks_mtx);
+        drain_submissions();
+
+        if (auto task = find_task(task_id))
+            return _tasks.value(*task).missed_runs();
+
+        return std::nullopt;
+    }
+
+    /*!
+     * \brief Get a snapshot of the lateness of the tasks run so far.
+     * \return ssts::scheduler_stats with the lateness distributions (count, mean, p50, p99, p99.9 and max).
+     *
+     * Lateness is only recorded if ssts::pool_options::lateness_stats is set, otherwise all the counts are zero.
+     * Each worker thread records the tasks it starts in its own histogram, which is merged into the snapshot,
+     * while dispatch lateness is recorded by the thread that dispatches due tasks: recording costs a clock read
+     * and a few counter updates per task, without any lock or read-modify-write atomic operation.
+     */
+    ssts::scheduler_stats stats() const
+    {
+        auto dispatch_to_start = std::make_unique<ssts::latency_histogram>();
+        auto scheduled_to_start = std::make_unique<ssts::latency_histogram>();
+        _tp.merge_stats(*dispatch_to_start, *scheduled_to_start);
+
+        ssts::scheduler_stats s;
+        s.scheduled_to_dispatch = _dispatch_lateness.summary();
+        s.dispatch_to_start = dispatch_to_start->summary();
+        s.scheduled_to_start = scheduled_to_start->summary();
+        return s;
+    }
+
+    /*!
+     * \brief Get a snapshot of the utilization of the underlying ssts::task_pool.
+     * \return ssts::pool_stats, see ssts::task_pool::stats and ssts::pool_options::utilization_stats.
+     */
+    ssts::pool_stats pool_stats() const
+    {
+        return _tp.stats();
+    }
+
+    /*!
+     * \brief Get the execution metrics of a task.
+     * \param task_id task_id to query.
+     * \return ssts::task_metrics of all the runs of the tasks with the given task_id, std::nullopt if none is known.
+     *
+     * Metrics are only recorded if ssts::scheduler_options::per_task_metrics is set.
+     * They are looked up by task_id (no scan of the scheduled tasks) and outlive the dispatch of one-shot tasks:
+     * they are dropped by ssts::task_scheduler::remove_task (once no task with the given task_id is left) and by ssts::task_scheduler::stop,
+     * while at most ssts::scheduler_options::max_retired_metrics task_ids that are no longer scheduled are kept.
+     * Tasks with the same task_id (i.e. duplicates, or a task scheduled again after it has run) accumulate into the same metrics.
+     */
+    std::optional<ssts::task_metrics> metrics(const std::string& task_id)
+    {
+        std::scoped_lock lock(_update_tasks_mtx);
+        drain_submissions();
+
+        if (auto m = _task_metrics.find(_hasher(task_id)); m != _task_metrics.end())
+            return m->second->snapshot();
+
+        return std::nullopt;
+    }
+
+    /*!
+     * \brief Get the number of scheduler thread wake-ups saved by timer slack.
+     * \return Number of distinct time points that have been dispatched together with an earlier one.
+     *
+     * Each wake-up of the scheduler thread that dispatches tasks with k distinct time points adds k - 1 to this counter:
+     * without slack, each of them would have needed its own wake-up.
+     * The counter is only updated when some timer slack is set.
+     */
+    size_t wakeups_saved() const
+    {
+        return _wakeups_saved.load(std::memory_order_relaxed);
+    }
+
     template <typename TaskFunction>
     auto at(ssts::clock::time_point &&timepoint, TaskFunction &&func)
         -> std::future<std::invoke_result_t<TaskFunction>>
     {
-        auto task = [t = std::forward<TaskFunction>(func)] 
-        {
-            return t();
-        };
+        return at(ssts::priority::normal, std::move(timepoint), std::forward<TaskFunction>(func));
+    }
 
-        using ReturnType = std::invoke_result_t<TaskFunction>;
-        auto task_wrapper = std::packaged_task<ReturnType()>(task);
-        std::future<ReturnType> future = task_wrapper.get_future();
+    template <typename TaskFunction, typename... Args>
+    auto at(ssts::clock::time_point &&timepoint, TaskFunction &&func, Args &&... args)
+        -> std::future<std::invoke_result_t<TaskFunction, Args...>>
+    {
+        return at(ssts::priority::normal, std::move(timepoint), std::forward<TaskFunction>(func), std::forward<Args>(args)...);
+    }
 
-        add_task(std::move(timepoint), schedulable_task(std::move(task_wrapper)));
-        return future;
+    template <typename TaskFunction, typename... Args>
+    auto at(std::string&& task_id, ssts::clock::time_point &&timepoint, TaskFunction &&func, Args &&... args)
+        -> std::future<std::invoke_result_t<TaskFunction, Args...>>
+    {
+        return at(ssts::priority::normal, std::move(task_id), std::move(timepoint), std::forward<TaskFunction>(func), std::forward<Args>(args)...);
     }
 
+    /*!
+     * \brief Schedule a task with the given priority at the given time point.
+     * \param task_priority Priority of the task in the ssts::task_pool queue once it is due.
+     * \param timepoint Time point at which the task is run.
+     * \param func Callable object.
+     * \param args Parameters forwarded to func.
+     * \return std::future task result
+     *
+     * Due tasks with higher priority are run first (e.g. a heartbeat is not delayed by a burst of bulk tasks),
+     * see ssts::pool_options::starvation_timeout.
+     */
     template <typename TaskFunction, typename... Args>
-    auto at(ssts::clock::time_point &&timepoint, TaskFunction &&func, Args &&... args)
+    auto at(ssts::priority task_priority, ssts::clock::time_point &&timepoint, TaskFunction &&func, Args &&... args)
         -> std::future<std::invoke_result_t<TaskFunction, Args...>>
     {
         auto task = [t = std::forward<TaskFunction>(func), params = std::make_tuple(std::forward<Args>(args)...)] 
@@ -405,12 +885,21 @@ public:
         auto task_wrapper = std::packaged_task<ReturnType()>(task);
         std::future<ReturnType> future = task_wrapper.get_future();
 
-        add_task(std::move(timepoint), schedulable_task(std::move(task_wrapper)));
+        add_task(std::move(timepoint), schedulable_task(std::move(task_wrapper)), task_priority);
         return future;
     }
 
+    /*!
+     * \brief Schedule a task with the given priority and a task_id at the given time point.
+     * \param task_priority Priority of the task in the ssts::task_pool queue once it is due.
+     * \param task_id Task identifier.
+     * \param timepoint Time point at which the task is run.
+     * \param func Callable object.
+     * \param args Parameters forwarded to func.
+     * \return std::future task result
+     */
     template <typename TaskFunction, typename... Args>
-    auto at(std::string&& task_id, ssts::clock::time_point &&timepoint, TaskFunction &&func, Args &&... args)
+    auto at(ssts::priority task_priority, std::string&& task_id, ssts::clock::time_point &&timepoint, TaskFunction &&func, Args &&... args)
         -> std::future<std::invoke_result_t<TaskFunction, Args...>>
     {
         auto task = [t = std::forward<TaskFunction>(func), params = std::make_tuple(std::forward<Args>(args)...)] 
@@ -422,7 +911,7 @@ public:
         auto task_wrapper = std::packaged_task<ReturnType()>(task);
         std::future<ReturnType> future = task_wrapper.get_future();
 
-        add_task(std::move(timepoint), schedulable_task(std::move(task_wrapper), _hasher(task_id)));
+        add_task(std::move(timepoint), schedulable_task(std::move(task_wrapper), _hasher(task_id)), task_priority);
         return future;
     }
 
@@ -456,112 +945,680 @@ public:
             std::forward<Args>(args)...);
     }
 
+    /*!
+     * \brief Schedule a task with the given priority after the given duration.
+     * \param task_priority Priority of the task in the ssts::task_pool queue once it is due.
+     * \param duration Delay after which the task is run.
+     * \param func Callable object.
+     * \param args Parameters forwarded to func.
+     * \return std::future task result
+     */
+    template <typename TaskFunction, typename... Args>
+    auto in(ssts::priority task_priority, ssts::clock::duration&& duration, TaskFunction &&func, Args &&... args)
+        -> std::future<std::invoke_result_t<TaskFunction, Args...>>
+    {
+        return at(
+            task_priority,
+            std::forward<ssts::clock::time_point>(ssts::clock::now() + duration),
+            std::forward<TaskFunction>(func),
+            std::forward<Args>(args)...);
+    }
+
+    /*!
+     * \brief Schedule a task with the given priority and a task_id after the given duration.
+     * \param task_priority Priority of the task in the ssts::task_pool queue once it is due.
+     * \param task_id Task identifier.
+     * \param duration Delay after which the task is run.
+     * \param func Callable object.
+     * \param args Parameters forwarded to func.
+     * \return std::future task result
+     */
+    template <typename TaskFunction, typename... Args>
+    auto in(ssts::priority task_priority, std::string&& task_id, ssts::clock::duration&& duration, TaskFunction &&func, Args &&... args)
+        -> std::future<std::invoke_result_t<TaskFunction, Args...>>
+    {
+        return at(
+            task_priority,
+            std::forward<std::string>(task_id),
+            std::forward<ssts::clock::time_point>(ssts::clock::now() + duration),
+            std::forward<TaskFunction>(func),
+            std::forward<Args>(args)...);
+    }
+
+    /*!
+     * \brief Schedule a fire-and-forget task at the given time point.
+     * \param timepoint Time point at which the task is run.
+     * \param func Callable object.
+     * \param args Parameters forwarded to func.
+     *
+     * Detached counterpart of ssts::task_scheduler::at: the task result is discarded,
+     * hence no std::packaged_task and no std::future shared state are created.
+     */
+    template <typename TaskFunction, typename... Args>
+    void post_at(ssts::clock::time_point&& timepoint, TaskFunction&& func, Args&&... args)
+    {
+        add_task(std::move(timepoint), schedulable_task(make_detached_task(std::forward<TaskFunction>(func), std::forward<Args>(args)...)));
+    }
+
+    /*!
+     * \brief Schedule a fire-and-forget task with a task_id at the given time point.
+     * \param task_id Task identifier.
+     * \param timepoint Time point at which the task is run.
+     * \param func Callable object.
+     * \param args Parameters forwarded to func.
+     *
+     * Detached counterpart of ssts::task_scheduler::at: the task result is discarded,
+     * hence no std::packaged_task and no std::future shared state are created.
+     */
+    template <typename TaskFunction, typename... Args>
+    void post_at(std::string&& task_id, ssts::clock::time_point&& timepoint, TaskFunction&& func, Args&&... args)
+    {
+        add_task(std::move(timepoint), schedulable_task(make_detached_task(std::forward<TaskFunction>(func), std::forward<Args>(args)...), _hasher(task_id)));
+    }
+
+    /*!
+     * \brief Schedule a fire-and-forget task after the given duration.
+     * \param duration Delay after which the task is run.
+     * \param func Callable object.
+     * \param args Parameters forwarded to func.
+     *
+     * Detached counterpart of ssts::task_scheduler::in.
+     */
+    template <typename TaskFunction, typename... Args>
+    void post_in(ssts::clock::duration&& duration, TaskFunction&& func, Args&&... args)
+    {
+        post_at(
+            std::forward<ssts::clock::time_point>(ssts::clock::now() + duration),
+            std::forward<TaskFunction>(func),
+            std::forward<Args>(args)...);
+    }
+
+    /*!
+     * \brief Schedule a fire-and-forget task with a task_id after the given duration.
+     * \param task_id Task identifier.
+     * \param duration Delay after which the task is run.
+     * \param func Callable object.
+     * \param args Parameters forwarded to func.
+     *
+     * Detached counterpart of ssts::task_scheduler::in.
+     */
+    template <typename TaskFunction, typename... Args>
+    void post_in(std::string&& task_id, ssts::clock::duration&& duration, TaskFunction&& func, Args&&... args)
+    {
+        post_at(
+            std::forward<std::string>(task_id),
+            std::forward<ssts::clock::time_point>(ssts::clock::now() + duration),
+            std::forward<TaskFunction>(func),
+            std::forward<Args>(args)...);
+    }
+
+    /*!
+     * \brief Schedule a task at the given time point, returning an ssts::future.
+     * \param timepoint Time point at which the task is run.
+     * \param func Callable object.
+     * \param args Parameters forwarded to func.
+     * \return ssts::future task result
+     *
+     * Continuations attached with ssts::future::then run on the ssts::task_pool worker that executed the task.
+     * If the task is removed before running, the future holds a std::future_error (broken_promise).
+     */
+    template <typename TaskFunction, typename... Args>
+    auto submit_at(ssts::clock::time_point&& timepoint, TaskFunction&& func, Args&&... args)
+    {
+        auto [task, future] = make_promised_task(std::forward<TaskFunction>(func), std::forward<Args>(args)...);
+        add_task(std::move(timepoint), schedulable_task(std::move(task)));
+        return std::move(future);
+    }
+
+    /*!
+     * \brief Schedule a task with a task_id at the given time point, returning an ssts::future.
+     * \param task_id Task identifier.
+     * \param timepoint Time point at which the task is run.
+     * \param func Callable object.
+     * \param args Parameters forwarded to func.
+     * \return ssts::future task result
+     */
+    template <typename TaskFunction, typename... Args>
+    auto submit_at(std::string&& task_id, ssts::clock::time_point&& timepoint, TaskFunction&& func, Args&&... args)
+    {
+        auto [task, future] = make_promised_task(std::forward<TaskFunction>(func), std::forward<Args>(args)...);
+        add_task(std::move(timepoint), schedulable_task(std::move(task), _hasher(task_id)));
+        return std::move(future);
+    }
+
+    /*!
+     * \brief Schedule a task after the given duration, returning an ssts::future.
+     * \param duration Delay after which the task is run.
+     * \param func Callable object.
+     * \param args Parameters forwarded to func.
+     * \return ssts::future task result
+     */
+    template <typename TaskFunction, typename... Args>
+    auto submit_in(ssts::clock::duration&& duration, TaskFunction&& func, Args&&... args)
+    {
+        return submit_at(
+            std::forward<ssts::clock::time_point>(ssts::clock::now() + duration),
+            std::forward<TaskFunction>(func),
+            std::forward<Args>(args)...);
+    }
+
+    /*!
+     * \brief Schedule a task with a task_id after the given duration, returning an ssts::future.
+     * \param task_id Task identifier.
+     * \param duration Delay after which the task is run.
+     * \param func Callable object.
+     * \param args Parameters forwarded to func.
+     * \return ssts::future task result
+     */
+    template <typename TaskFunction, typename... Args>
+    auto submit_in(std::string&& task_id, ssts::clock::duration&& duration, TaskFunction&& func, Args&&... args)
+    {
+        return submit_at(
+            std::forward<std::string>(task_id),
+            std::forward<ssts::clock::time_point>(ssts::clock::now() + duration),
+            std::forward<TaskFunction>(func),
+            std::forward<Args>(args)...);
+    }
+
+    /*!
+     * \brief Schedule many fire-and-forget tasks at once.
+     * \param first Iterator to the first ssts::batch_task.
+     * \param last Iterator past the last ssts::batch_task.
+     * \param is_presorted true if the tasks are sorted by time point.
+     *
+     * All the tasks are moved from the given range and inserted in a single critical section,
+     * and the scheduler thread is notified at most once.
+     * When the range is sorted by time point, each task is inserted next to the previous one:
+     * building the task queue is linear instead of O(n log n).
+     * Duplicated task_ids are rejected as in ssts::task_scheduler::post_at.
+     */
+    template <typename InputIt>
+    void post_batch(InputIt first, InputIt last, bool is_presorted = false)
+    {
+        if (!_is_running)
+            return;
+
+        auto earliest = ssts::clock::time_point::max();
+        {
+            std::scoped_lock lock(_update_tasks_mtx);
+
+            // Tasks submitted before this call are inserted first, as if they were part of the same sequence.
+            drain_submissions();
+
+            // Rehash the task_id index at most once.
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+                _task_index.reserve(_task_index.size() + static_cast<size_t>(std::distance(first, last)));
+
+            std::optional<task_handle> previous;
+            for (; first != last; ++first)
+            {
+                auto&& bt = *first;
+                const auto hash = bt.task_id.has_value() ? std::make_optional(_hasher(bt.task_id.value())) : std::nullopt;
+                if (!_is_duplicate_allowed && already_exists(hash))
+                    continue;
+
+                schedulable_task st(std::move(bt.task), hash, bt.interval);
+                st.set_priority(bt.task_priority);
+                attach_metrics(st);
+                auto task = is_presorted && previous.has_value() 
+                    ? _tasks.insert(previous.value(), bt.timepoint, std::move(st)) 
+                    : _tasks.insert(bt.timepoint, std::move(st));
+
+                if (hash.has_value())
+                    _task_index.emplace(hash.value(), task);
+
+                SSTS_TRACE(insert, hash.value_or(0));
+                earliest = std::min(earliest, bt.timepoint);
+                previous = task;
+            }
+        }
+
+        if (earliest < _next_task_timepoint.load())
+            notify_scheduler();
+    }
+
     template <typename TaskFunction>
     void every(ssts::clock::duration&& interval, TaskFunction &&func)
     {
-        auto task = [t = std::forward<TaskFunction>(func)] 
-        {
-            return t(); 
-        };
-        add_task(std::move(ssts::clock::now()), schedulable_task(std::move(task), interval));
+        every(ssts::priority::normal, std::move(interval), std::forward<TaskFunction>(func));
     }
 
     template <typename TaskFunction, typename... Args>
     void every(ssts::clock::duration&& interval, TaskFunction &&func, Args &&... args)
+    {
+        every(ssts::priority::normal, std::move(interval), std::forward<TaskFunction>(func), std::forward<Args>(args)...);
+    }
+
+    template <typename TaskFunction, typename... Args>
+    void every(std::string&& task_id, ssts::clock::duration&& interval, TaskFunction &&func, Args &&... args)
+    {
+        every(ssts::priority::normal, std::move(task_id), std::move(interval), std::forward<TaskFunction>(func), std::forward<Args>(args)...);
+    }
+
+    /*!
+     * \brief Schedule a recursive task with the given priority.
+     * \param task_priority Priority of each run in the ssts::task_pool queue once it is due.
+     * \param interval Interval between two runs.
+     * \param func Callable object.
+     * \param args Parameters forwarded to func.
+     */
+    template <typename TaskFunction, typename... Args>
+    void every(ssts::priority task_priority, ssts::clock::duration&& interval, TaskFunction &&func, Args &&... args)
     {
         auto task = [t = std::forward<TaskFunction>(func), params = std::make_tuple(std::forward<Args>(args)...)] 
         {
             return std::apply(t, params);
         };
-        add_task(std::move(ssts::clock::now()), schedulable_task(std::move(task), interval));
+        add_task(std::move(ssts::clock::now()), schedulable_task(std::move(task), interval), task_priority);
     }
 
+    /*!
+     * \brief Schedule a recursive task with the given priority and a task_id.
+     * \param task_priority Priority of each run in the ssts::task_pool queue once it is due.
+     * \param task_id Task identifier.
+     * \param interval Interval between two runs.
+     * \param func Callable object.
+     * \param args Parameters forwarded to func.
+     */
     template <typename TaskFunction, typename... Args>
-    void every(std::string&& task_id, ssts::clock::duration&& interval, TaskFunction &&func, Args &&... args)
+    void every(ssts::priority task_priority, std::string&& task_id, ssts::clock::duration&& interval, TaskFunction &&func, Args &&... args)
     {
         auto task = [t = std::forward<TaskFunction>(func), params = std::make_tuple(std::forward<Args>(args)...)] 
         {
             return std::apply(t, params);
         };
-        add_task(std::move(ssts::clock::now()), schedulable_task(std::move(task), _hasher(task_id), interval));
+        add_task(std::move(ssts::clock::now()), schedulable_task(std::move(task), _hasher(task_id), interval), task_priority);
     }
 
 private:
     ssts::task_pool _tp;
     std::atomic_bool _is_running;
     std::atomic_bool _is_duplicate_allowed;
+    std::vector<unsigned int> _scheduler_cpus;
+    ssts::wait_strategy _wait;
+    std::unique_ptr<ssts::timerfd_timer> _timer;
+    ssts::clock::duration _timer_slack;
+    std::atomic_bool _has_slack;
+    ssts::dispatch_mode _dispatch;
+    std::atomic<size_t> _wakeups_saved{ 0 };
+    const bool _is_recording_metrics;
+    const size_t _max_retired_metrics;
+    const std::pair<ssts::missed_run_policy, size_t> _missed_run_policy;
+    std::vector<ssts::clock::time_point> _due_time_points;
+    // Only written in update_tasks(), with _update_tasks_mtx held.
+    ssts::latency_histogram _dispatch_lateness;
     std::thread _scheduler_thread;
-    std::multimap<ssts::clock::time_point, schedulable_task> _tasks;
+    queue_type _tasks;
+    ssts::mpsc_queue<submitted_task> _submissions;
+    std::unordered_multimap<size_t, task_handle> _task_index;
+    std::unordered_map<size_t, std::shared_ptr<task_counters>> _task_metrics;
+    std::deque<size_t> _retired_metrics;
+    std::vector<task_handle> _due_tasks;
+    std::vector<ssts::task_pool::batch_entry> _dispatch_tasks;
     std::condition_variable _update_tasks_cv;
     std::mutex _update_tasks_mtx;
     std::hash<std::string> _hasher;
     std::atomic<ssts::clock::time_point> _next_task_timepoint;
 
-    void add_task(ssts::clock::time_point&& timepoint, schedulable_task&& st)
+    template <typename TaskFunction, typename... Args>
+    static auto make_detached_task(TaskFunction&& func, Args&&... args)
+    {
+        return [t = std::forward<TaskFunction>(func), params = std::make_tuple(std::forward<Args>(args)...)] 
+        {
+            std::apply(t, params);
+        };
+    }
+
+    template <typename TaskFunction, typename... Args>
+    static auto make_promised_task(TaskFunction&& func, Args&&... args)
+    {
+        using ReturnType = std::invoke_result_t<TaskFunction, Args...>;
+        ssts::promise<ReturnType> p;
+        auto future = p.get_future();
+
+        auto task = [p = std::move(p), t = std::forward<TaskFunction>(func), params = std::make_tuple(std::forward<Args>(args)...)]() mutable
+        {
+            detail::set_promise_from(p, [&t, &params] { return std::apply(t, params); });
+        };
+
+        return std::make_pair(std::move(task), std::move(future));
+    }
+
+    // Options of the ssts::pool_options constructor: default scheduler thread options.
+    static ssts::scheduler_options make_scheduler_options(const ssts::pool_options& pool_options)
+    {
+        ssts::scheduler_options options;
+        options.pool = pool_options;
+        return options;
+    }
+
+    // Producers never take _update_tasks_mtx to submit a task: tasks are pushed into the lock-free _submissions queue,
+    // which is drained into _tasks by the scheduler thread (or by any API that looks tasks up).
+    // The scheduler thread is only notified if the new task is due before the one it is currently waiting for.
+    void add_task(ssts::clock::time_point&& timepoint, schedulable_task&& st, ssts::priority task_priority = ssts::priority::normal)
     {
         if (!_is_running)
             return;
 
+        SSTS_TRACE(submit, st.hash().value_or(0));
+        st.set_priority(task_priority);
+        _submissions.push(submitted_task{ timepoint, std::move(st) });
+
+        if (add_slack(timepoint, _timer_slack) < _next_task_timepoint.load())
         {
-            std::scoped_lock lock(_update_tasks_mtx);
+            // Acquiring the mutex makes sure that the scheduler thread is either waiting on _update_tasks_cv
+            // or has not checked _submissions yet: the notification cannot be lost.
+            // The timerfd backend counts notifications in its eventfd, hence it does not need the mutex.
+            if (!_timer)
+            {
+                std::scoped_lock lock(_update_tasks_mtx);
+            }
 
-            if (already_exists(st.hash()))
-                return;
+            notify_scheduler();
+        }
+    }
+
+    void notify_scheduler()
+    {
+        if (_timer)
+            _timer->notify();
+        else
+            _update_tasks_cv.notify_one();
+    }
+
+    // Must be called with _update_tasks_mtx held, which is released while sleeping.
+    // Returns true if timepoint has been reached, false if woken up by a notification (or spuriously).
+    bool park_until(std::unique_lock<std::mutex>& lock, const ssts::clock::time_point& timepoint)
+    {
+        if (_timer)
+        {
+            lock.unlock();
+            const bool is_expired = _timer->wait_until(timepoint);
+            lock.lock();
+            return is_expired;
+        }
 
-            _tasks.emplace(std::move(timepoint), std::move(st));
+        if (timepoint == ssts::clock::time_point::max())
+        {
+            _update_tasks_cv.wait(lock);
+            return false;
         }
 
-        _update_tasks_cv.notify_one();
+        return _update_tasks_cv.wait_until(lock, timepoint) == std::cv_status::timeout;
     }
 
-    void update_tasks()
+    // Must be called with _update_tasks_mtx held, which is released while waiting.
+    // Waits for the next time point and collects the due tasks into _dispatch_tasks, returning true.
+    // Returns false if woken up before (e.g. by a new submission or by stop()): the caller is expected to call it again.
+    bool wait_for_due_tasks(std::unique_lock<std::mutex>& lock)
     {
-        decltype(_tasks) recursive_tasks;
+        // stop() clears _is_running with _update_tasks_mtx held, then notifies:
+        // checking it here makes sure that the notification is not sent before parking.
+        if (!_is_running)
+            return false;
 
-        // All the tasks whose start time is before ssts::clock::now(),
-        // (which are the ones from _tasks.begin(), up to last_task_to_process)
-        // can be enqueued in the TaskPool.
-        auto last_task_to_process = _tasks.upper_bound(ssts::clock::now());
-        for (auto it = _tasks.begin(); it != last_task_to_process; it++)
+        // Publish the next timepoint before checking for new submissions:
+        // a producer either sees the updated _next_task_timepoint (and notifies if its task is earlier),
+        // or its submission is seen here and drained at the next call.
+        drain_submissions();
+        _next_task_timepoint = next_wakeup_time_point();
+        if (!_submissions.empty())
+            return false;
+
+        if (_tasks.empty())
+        {
+            park_until(lock, ssts::clock::time_point::max());
+            return false;
+        }
+
+        if (!_wait.is_spinning())
+        {
+            // Check if the scheduler thread is woken up because of a timeout (i.e. _next_task_timepoint has just been reached),
+            // or because of a new notification (i.e. a task earlier than _next_task_timepoint has been submitted): 
+            // in case of a timeout proceed with update_tasks(), otherwise return.
+            if (!park_until(lock, _next_task_timepoint.load()))
+                return false;
+        }
+        else
         {
-            if(it->second.is_enabled())
+            // Park until the spin window before the next time point, then busy wait without holding the mutex:
+            // new submissions (or a stop request) interrupt the busy wait as a notification would.
+            const auto next_timepoint = _next_task_timepoint.load();
+            const auto spin_window = _wait.spin_duration + _wait.yield_duration;
+            if (next_timepoint - ssts::clock::now() > spin_window)
             {
-                _tp.run([t = it->second.clone()] { t->invoke(); }, it->second.hash());
+                park_until(lock, next_timepoint - spin_window);
+                return false;
             }
 
-            // Keep track of recursive tasks if task has a valid interval value.
-            if (it->second.interval().has_value())
+            // The lock is released while spinning: other callers may drain _submissions meanwhile, which is safe with ssts::mpsc_queue::empty.
+            lock.unlock();
+            const bool is_reached = ssts::spin_wait_until(_wait, next_timepoint, [this] { return !_submissions.empty() || !_is_running; });
+            lock.lock();
+            if (!is_reached)
+                return false;
+        }
+
+        if (!_is_running)
+            return false;
+
+        // Tasks submitted while sleeping were not earlier than the wake-up time point, but with slack they may be due:
+        // drain them, so that they are dispatched by this wake-up.
+        drain_submissions();
+        update_tasks();
+        return true;
+    }
+
+    // Body of the leader task of ssts::dispatch_mode::leader_follower, run by a ssts::task_pool worker.
+    // Only the leader pushes tasks to the pool: if they are still queued while no other worker is idle,
+    // the leader runs them before waiting for the next time point.
+    // Once tasks are due, the next leader is queued with high priority (so that it does not wait behind normal priority due tasks)
+    // and the first highest priority due task is run on this thread, without any thread hop.
+    // Tasks are pushed with _update_tasks_mtx held: the next leader cannot touch _dispatch_tasks before they are all queued.
+    void lead()
+    {
+        std::unique_lock lock(_update_tasks_mtx);
+        while (_is_running)
+        {
+            if (_tp.is_saturated())
             {
-                // Make sure that next_start_time is greater than ssts::clock::now(), 
-                // otherwise the task is scheduled in the past.
-                // Increment next_start_time starting from current start_time with a step equal to t->interval().value()
-                // in order to keep the scheduling with a fixed sample rate.
-                const auto task_interval = it->second.interval().value();
-                auto task_next_start_time = it->first + task_interval;
-                const auto now = ssts::clock::now();
-                while(now > task_next_start_time)
-                    task_next_start_time += task_interval;
-
-                recursive_tasks.emplace(std::move(task_next_start_time), std::move(it->second));
+                lock.unlock();
+                _tp.run_pending_task();
+                lock.lock();
+                continue;
             }
+
+            if (!wait_for_due_tasks(lock) || _dispatch_tasks.empty())
+                continue;
+
+            auto own_task = std::max_element(_dispatch_tasks.begin(), _dispatch_tasks.end(), [](const auto& a, const auto& b) { return a.task_priority < b.task_priority; });
+            auto task = std::move(*own_task);
+            _dispatch_tasks.erase(own_task);
+            add_leader_task();
+            _tp.push_tasks(_dispatch_tasks);
+            lock.unlock();
+
+            _tp.run_inline(std::move(task));
+            return;
         }
+    }
+
+    // The leader task is given a null deadline, so that its lateness is not reported (see ssts::pool_options::lateness_callback).
+    void add_leader_task()
+    {
+        _dispatch_tasks.emplace_back(std::nullopt, ssts::task([this] { lead(); }), ssts::priority::high, ssts::clock::time_point{});
+    }
+
+    static ssts::clock::time_point add_slack(const ssts::clock::time_point& timepoint, ssts::clock::duration slack)
+    {
+        return timepoint > ssts::clock::time_point::max() - slack ? ssts::clock::time_point::max() : timepoint + slack;
+    }
+
+    // Must be called with _update_tasks_mtx held.
+    // Without slack this is the earliest time point. Otherwise it is the earliest time point plus slack among all tasks,
+    // which is found by only visiting the tasks earlier than the current minimum (not later than the queue time point).
+    ssts::clock::time_point next_wakeup_time_point()
+    {
+        if (_tasks.empty())
+            return ssts::clock::time_point::max();
+
+        const auto next_timepoint = _tasks.next_time_point();
+        if (!_has_slack)
+            return next_timepoint;
 
-        // Erase tasks already processed.
-        _tasks.erase(_tasks.begin(), last_task_to_process);
+        auto wakeup_timepoint = ssts::clock::time_point::max();
+        _tasks.for_each_before(wakeup_timepoint, [this, &wakeup_timepoint](task_handle task)
+        {
+            const auto slack = _tasks.value(task).slack().value_or(_timer_slack);
+            wakeup_timepoint = std::min(wakeup_timepoint, add_slack(_tasks.time_point(task), slack));
+            return wakeup_timepoint;
+        });
 
-        // Re-schedule recursive tasks.
-        _tasks.merge(recursive_tasks);
+        return std::max(next_timepoint, wakeup_timepoint);
     }
 
-    auto get_task_iterator(const std::string& task_id) -> decltype(_tasks)::iterator
+    // Must be called with _update_tasks_mtx held.
+    void drain_submissions()
     {
-        return std::find_if(_tasks.begin(), _tasks.end(), [hash = _hasher(task_id)](auto&& it) {
-            if (it.second.hash().has_value())
+        while (auto submitted = _submissions.pop())
+        {
+            auto& st = submitted->task;
+            if (!_is_duplicate_allowed && already_exists(st.hash()))
+                continue;
+
+            const auto hash = st.hash();
+            attach_metrics(st);
+            auto task = _tasks.insert(submitted->timepoint, std::move(st));
+            if (hash.has_value())
+                _task_index.emplace(hash.value(), task);
+
+            SSTS_TRACE(insert, hash.value_or(0));
+        }
+    }
+
+    void update_tasks()
+    {
+        // All the tasks whose start time is before ssts::clock::now()
+        // can be enqueued in the TaskPool.
+        // One-shot tasks are moved into the TaskPool and erased,
+        // while recursive tasks share their callable with the TaskPool and are re-scheduled in place,
+        // so that no allocation takes place when a task is fired.
+        // The scheduled time point is handed over as the task deadline (see ssts::queue_order).
+        const auto now = ssts::clock::now();
+        _due_tasks.clear();
+        _tasks.collect_due(now, _due_tasks);
+        if (_has_slack)
+            count_wakeups_saved();
+
+        for (auto task : _due_tasks)
+        {
+            auto& st = _tasks.value(task);
+            SSTS_TRACE(expire, st.hash().value_or(0));
+
+            if (_tp._is_recording_stats && st.is_enabled())
+                _dispatch_lateness.record(now - _tasks.time_point(task));
+
+            if (!st.interval().has_value())
             {
-                return hash == it.second.hash().value();
+                if (st.is_enabled())
+                    _dispatch_tasks.emplace_back(st.hash(), st.release(), st.priority(), _tasks.time_point(task));
+
+                const auto hash = st.hash();
+                erase_task(task);
+                retire_metrics(hash);
+                continue;
             }
-            return false;
-        });
+
+            if (st.is_enabled())
+                _dispatch_tasks.emplace_back(st.hash(), st.share(), st.priority(), _tasks.time_point(task));
+
+            // Make sure that next_start_time is not before ssts::clock::now(), 
+            // otherwise the task is scheduled in the past: the next slot on the time grid of the task
+            // (i.e. start_time plus a multiple of its interval) is computed at once, the slots skipped over are missed runs.
+            const auto task_interval = st.interval().value();
+            auto [task_next_start_time, missed_runs] = first_slot_not_before(_tasks.time_point(task) + task_interval, task_interval, now);
+            if (missed_runs > 0)
+            {
+                st.add_missed_runs(missed_runs);
+
+                const auto [policy, max_burst] = st.missed_run_policy().value_or(_missed_run_policy);
+                if (policy == ssts::missed_run_policy::run_once)
+                {
+                    task_next_start_time = now + task_interval;
+                }
+                else if (policy == ssts::missed_run_policy::burst && st.is_enabled())
+                {
+                    // Replayed runs are not duplicates: they are exempt from duplicate suppression (see set_duplicate_allowed),
+                    // otherwise the pool would drop those popped while an earlier run is still active.
+                    const auto replayed_runs = std::min<uint64_t>(missed_runs, max_burst);
+                    for (auto slot = task_next_start_time - task_interval * replayed_runs; slot < task_next_start_time; slot += task_interval)
+                        _dispatch_tasks.emplace_back(st.hash(), st.share(), st.priority(), slot, true);
+                }
+            }
+
+            reschedule_task(task, task_next_start_time);
+        }
+    }
+
+    // First time point not before now on the grid starting at first with the given interval (O(1), however late the grid is),
+    // and the number of slots before it.
+    static std::pair<ssts::clock::time_point, uint64_t> first_slot_not_before(ssts::clock::time_point first, ssts::clock::duration interval, ssts::clock::time_point now)
+    {
+        if (now <= first || interval <= ssts::clock::duration{ 0 })
+            return { first, 0 };
+
+        const auto slots = static_cast<uint64_t>((now - first + interval - ssts::clock::duration{ 1 }) / interval);
+        return { first + interval * slots, slots };
+    }
+
+    void count_wakeups_saved()
+    {
+        _due_time_points.clear();
+        for (auto task : _due_tasks)
+            _due_time_points.push_back(_tasks.time_point(task));
+
+        std::sort(_due_time_points.begin(), _due_time_points.end());
+        const auto distinct = std::unique(_due_time_points.begin(), _due_time_points.end()) - _due_time_points.begin();
+        if (distinct > 1)
+            _wakeups_saved.fetch_add(static_cast<size_t>(distinct - 1), std::memory_order_relaxed);
+    }
+
+    // Tasks with a task_id share the metrics of their task_id, created the first time it is scheduled.
+    void attach_metrics(schedulable_task& st)
+    {
+        if (!_is_recording_metrics || !st.hash().has_value())
+            return;
+
+        auto& metrics = _task_metrics[st.hash().value()];
+        if (!metrics)
+            metrics = std::make_shared<task_counters>();
+
+        st.set_metrics(metrics);
+    }
+
+    // Called once a one-shot task has been dispatched: its metrics are kept until max_retired_metrics
+    // more task_ids are retired, unless a task with the same task_id has been scheduled again by then.
+    void retire_metrics(const std::optional<size_t>& opt_hash)
+    {
+        if (!_is_recording_metrics || !opt_hash.has_value() || already_exists(opt_hash))
+            return;
+
+        _retired_metrics.push_back(opt_hash.value());
+        while (_retired_metrics.size() > _max_retired_metrics)
+        {
+            if (!already_exists(_retired_metrics.front()))
+                _task_metrics.erase(_retired_metrics.front());
+
+            _retired_metrics.pop_front();
+        }
+    }
+
+    std::optional<task_handle> find_task(const std::string& task_id)
+    {
+        if (auto index_entry = _task_index.find(_hasher(task_id)); index_entry != _task_index.end())
+            return index_entry->second;
+
+        return std::nullopt;
     }
 
     bool already_exists(const std::optional<size_t>& opt_hash)
@@ -569,14 +1626,43 @@ private:
         if (!opt_hash.has_value())
             return false;
 
-        return std::any_of(_tasks.begin(), _tasks.end(), [hash=opt_hash.value()](auto&& it){
-            if (it.second.hash().has_value())
-            {
-                return hash == it.second.hash().value();
-            }
-            return false;
-        });
+        return _task_index.find(opt_hash.value()) != _task_index.end();
+    }
+
+    // Tasks sharing the same task_id (i.e. duplicates) share the same index key:
+    // only their entries need to be scanned to find the one that refers to the given task.
+    auto find_index_entry(task_handle task) -> typename decltype(_task_index)::iterator
+    {
+        const auto hash = _tasks.value(task).hash();
+        if (!hash.has_value())
+            return _task_index.end();
+
+        auto [first, last] = _task_index.equal_range(hash.value());
+        auto index_entry = std::find_if(first, last, [task](auto&& entry) { return entry.second == task; });
+        return index_entry != last ? index_entry : _task_index.end();
+    }
+
+    void erase_task(task_handle task)
+    {
+        if (auto index_entry = find_index_entry(task); index_entry != _task_index.end())
+            _task_index.erase(index_entry);
+
+        _tasks.erase(task);
+    }
+
+    void reschedule_task(task_handle task, ssts::clock::time_point timepoint)
+    {
+        auto index_entry = find_index_entry(task);
+        auto rescheduled_task = _tasks.reschedule(task, timepoint);
+
+        if (index_entry != _task_index.end())
+            index_entry->second = rescheduled_task;
     }
 };
 
+/*! \typedef task_scheduler
+ *  \brief ssts::basic_task_scheduler using the default ssts::multimap_queue.
+ */
+using task_scheduler = basic_task_scheduler<>;
+
 }
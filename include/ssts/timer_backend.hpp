@@ -0,0 +1,161 @@
+/*!
+ * \file timer_backend.hpp
+ * \author Stefano Lusardi
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <system_error>
+
+#if defined(__linux__)
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+    #include <sys/timerfd.h>
+    #include <time.h>
+    #include <unistd.h>
+#endif
+
+#include "clock.hpp"
+
+namespace ssts
+{
+/*! \enum timer_backend
+ *  \brief How the ssts::basic_task_scheduler thread sleeps until the next task time point.
+ */
+enum class timer_backend
+{
+    condition_variable, /*!< std::condition_variable::wait_until (portable, default). */
+    timerfd             /*!< Linux only: an absolute CLOCK_MONOTONIC timerfd and an eventfd for new submissions, polled with epoll. Falls back to condition_variable elsewhere. */
+};
+
+/*! \class timerfd_timer
+ *  \brief Sleep until an absolute time point, or until notified, with timerfd, eventfd and epoll.
+ *
+ *  ssts::clock time points are passed to the kernel as absolute CLOCK_MONOTONIC deadlines,
+ *  hence no relative timeout is computed (and rounded) on each wait.
+ *  Notifications are counted by the eventfd, so a notification sent before wait_until is called is not lost.
+ *  Only one thread may call wait_until, any thread may call notify.
+ */
+class timerfd_timer
+{
+public:
+    /*!
+     * \brief Check if the platform supports this timer.
+     * \return bool true on Linux, where ssts::clock is CLOCK_MONOTONIC.
+     */
+    static constexpr bool is_supported()
+    {
+#if defined(__linux__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /*!
+     * \brief Constructor.
+     *
+     * Throws std::system_error if the file descriptors cannot be created (or on unsupported platforms).
+     */
+    timerfd_timer()
+    {
+#if defined(__linux__)
+        _timer_fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+        _event_fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        _epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+        if (_timer_fd < 0 || _event_fd < 0 || _epoll_fd < 0 || !watch(_timer_fd) || !watch(_event_fd))
+        {
+            const auto error = errno;
+            close_all();
+            throw std::system_error(error, std::system_category(), "timerfd_timer");
+        }
+#else
+        throw std::system_error(std::make_error_code(std::errc::function_not_supported), "timerfd_timer");
+#endif
+    }
+
+    timerfd_timer(const timerfd_timer&) = delete;
+    timerfd_timer& operator=(const timerfd_timer&) = delete;
+
+    ~timerfd_timer() { close_all(); }
+
+    /*!
+     * \brief Sleep until the given time point, or until notify is called.
+     * \param timepoint Absolute wake-up time point, ssts::clock::time_point::max() to sleep until notified.
+     * \return bool true if the time point has been reached, false if woken up by a notification (or by a signal).
+     */
+    bool wait_until(const ssts::clock::time_point& timepoint)
+    {
+#if defined(__linux__)
+        // A zero it_value disarms the timer: time points at or before the clock epoch are clamped to 1ns.
+        itimerspec spec{};
+        if (timepoint != ssts::clock::time_point::max())
+        {
+            const auto ns = std::max<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(timepoint.time_since_epoch()).count(), 1);
+            spec.it_value.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+            spec.it_value.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+        }
+        ::timerfd_settime(_timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr);
+
+        epoll_event events[2];
+        const auto count = ::epoll_wait(_epoll_fd, events, 2, -1);
+
+        bool is_expired = false;
+        for (int i = 0; i < count; ++i)
+        {
+            uint64_t value = 0;
+            if (events[i].data.fd == _timer_fd)
+                is_expired = ::read(_timer_fd, &value, sizeof(value)) == sizeof(value);
+            else
+                (void)::read(_event_fd, &value, sizeof(value));
+        }
+
+        return is_expired;
+#else
+        (void)timepoint;
+        return false;
+#endif
+    }
+
+    /*!
+     * \brief Wake up the thread blocked in wait_until (or make its next call return immediately).
+     */
+    void notify()
+    {
+#if defined(__linux__)
+        const uint64_t one = 1;
+        (void)::write(_event_fd, &one, sizeof(one));
+#endif
+    }
+
+private:
+    int _timer_fd = -1;
+    int _event_fd = -1;
+    int _epoll_fd = -1;
+
+#if defined(__linux__)
+    bool watch(int fd)
+    {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        return ::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+    }
+#endif
+
+    void close_all()
+    {
+#if defined(__linux__)
+        for (auto fd : { _timer_fd, _event_fd, _epoll_fd })
+            if (fd >= 0)
+                ::close(fd);
+#endif
+    }
+};
+
+}
@@ -0,0 +1,419 @@
+/*!
+ * \file timing_wheel_queue.hpp
+ * \author Stefano Lusardi
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "clock.hpp"
+
+namespace ssts
+{
+/*! \class timing_wheel_queue
+ *  \brief Timer queue based on a hierarchical timing wheel.
+ *
+ *  Time is divided in ticks of Tick duration, starting from the queue construction.
+ *  The wheel has several levels of 64 slots each: level L slots span 64^L ticks,
+ *  and a value is stored in the level of the most significant 6 bit group in which its tick differs from the current one.
+ *  Occupied slots are tracked by a 64 bit mask per level, so that the next occupied slot is found in O(1).
+ *
+ *  Insert and erase are O(1). Values are cascaded to lower levels as time advances,
+ *  at most once per level. Nodes are recycled through a free list, hence no allocation takes place
+ *  after the queue has reached its steady state size.
+ *
+ *  Values become due at the first tick boundary after their time point, i.e. they are never due early
+ *  but they can be late up to one Tick: Tick trades precision for fewer cascades and wake-ups.
+ *  See ssts::multimap_queue for a description of the timer queue interface.
+ *
+ *  \tparam T Type of the queued values.
+ *  \tparam Tick Duration of a wheel tick (i.e. the timer resolution).
+ */
+template<typename T, typename Tick = std::chrono::milliseconds>
+class timing_wheel_queue
+{
+    static constexpr unsigned slot_bits = 6;
+    static constexpr unsigned slot_count = 1u << slot_bits;
+    static constexpr unsigned level_count = (64 + slot_bits - 1) / slot_bits;
+    static constexpr unsigned expired_level = level_count;
+    static constexpr unsigned detached_level = level_count + 1;
+    static constexpr size_t nodes_per_chunk = 256;
+
+    struct node
+    {
+        ssts::clock::time_point timepoint;
+        uint64_t tick;
+        node* prev;
+        node* next;
+        unsigned level;
+        unsigned slot;
+        std::optional<T> value;
+    };
+
+    struct wheel_level
+    {
+        std::array<node*, slot_count> slots{};
+        uint64_t occupied = 0;
+    };
+
+public:
+    using handle = node*;
+
+    timing_wheel_queue()
+    : _origin{ ssts::clock::now() }
+    , _current_tick{ 0 }
+    , _expired{ nullptr }
+    , _free_nodes{ nullptr }
+    , _size{ 0 }
+    {
+    }
+
+    timing_wheel_queue(const timing_wheel_queue&) = delete;
+    timing_wheel_queue& operator=(const timing_wheel_queue&) = delete;
+
+    ~timing_wheel_queue() { clear(); }
+
+    handle insert(const ssts::clock::time_point& timepoint, T&& value)
+    {
+        node* n = allocate_node();
+        n->value.emplace(std::move(value));
+        n->timepoint = timepoint;
+        n->tick = to_tick(timepoint);
+        link(n);
+        ++_size;
+        return n;
+    }
+
+    // Insertion is O(1) anyway, hints are not needed.
+    handle insert(handle, const ssts::clock::time_point& timepoint, T&& value) { return insert(timepoint, std::move(value)); }
+
+    void erase(handle h)
+    {
+        unlink(h);
+        h->value.reset();
+        release_node(h);
+        --_size;
+    }
+
+    handle reschedule(handle h, const ssts::clock::time_point& timepoint)
+    {
+        unlink(h);
+        h->timepoint = timepoint;
+        h->tick = to_tick(timepoint);
+        link(h);
+        return h;
+    }
+
+    T& value(handle h) { return *h->value; }
+    ssts::clock::time_point time_point(handle h) const { return h->timepoint; }
+
+    bool empty() const { return _size == 0; }
+    size_t size() const { return _size; }
+
+    void clear()
+    {
+        auto release_list = [this](node* head)
+        {
+            while (head)
+            {
+                node* next = head->next;
+                head->value.reset();
+                release_node(head);
+                head = next;
+            }
+        };
+
+        release_list(_expired);
+        _expired = nullptr;
+
+        for (auto& l : _levels)
+        {
+            for (auto& slot : l.slots)
+            {
+                release_list(slot);
+                slot = nullptr;
+            }
+            l.occupied = 0;
+        }
+
+        _size = 0;
+    }
+
+    /*
+     * Values that are already expired are due immediately. Otherwise the first occupied slot of the lowest
+     * non empty level holds the earliest values: for level 0 the slot start is their exact tick,
+     * for higher levels the slot start is returned, at which the slot is cascaded to lower levels.
+     */
+    ssts::clock::time_point next_time_point() const
+    {
+        if (_expired)
+            return tick_to_time_point(_current_tick);
+
+        for (unsigned level = 0; level < level_count; ++level)
+        {
+            if (const auto occupied = _levels[level].occupied; occupied != 0)
+            {
+                const auto slot = static_cast<uint64_t>(count_trailing_zeros(occupied));
+                return tick_to_time_point(upper_bits(_current_tick, level) | (slot << (slot_bits * level)));
+            }
+        }
+
+        return ssts::clock::time_point::max();
+    }
+
+    void collect_due(const ssts::clock::time_point& now, std::vector<handle>& due)
+    {
+        const auto target_tick = now > _origin ? static_cast<uint64_t>(std::chrono::duration_cast<Tick>(now - _origin).count()) : 0u;
+        if (target_tick > _current_tick)
+            advance(target_tick);
+
+        for (node* n = _expired; n; )
+        {
+            node* next = n->next;
+            n->level = detached_level;
+            due.push_back(n);
+            n = next;
+        }
+        _expired = nullptr;
+    }
+
+    /*
+     * Expired values are visited first, then the occupied slots of each level in time order:
+     * a value in a slot starting at tick t has a time point later than tick t - 1,
+     * hence the visit stops at the first slot that starts at least one tick after the limit.
+     */
+    template<typename Function>
+    void for_each_before(ssts::clock::time_point limit, Function&& f)
+    {
+        auto visit_list = [&limit, &f](node* head)
+        {
+            for (node* n = head; n; n = n->next)
+                if (n->timepoint < limit)
+                    limit = f(n);
+        };
+
+        visit_list(_expired);
+
+        for (unsigned level = 0; level < level_count; ++level)
+        {
+            for (auto occupied = _levels[level].occupied; occupied != 0; occupied &= occupied - 1)
+            {
+                const auto slot = static_cast<uint64_t>(count_trailing_zeros(occupied));
+                const auto slot_tick = upper_bits(_current_tick, level) | (slot << (slot_bits * level));
+                if (tick_to_time_point(slot_tick - 1) >= limit)
+                    return;
+
+                visit_list(_levels[level].slots[slot]);
+            }
+        }
+    }
+
+private:
+    ssts::clock::time_point _origin;
+    uint64_t _current_tick;
+    std::array<wheel_level, level_count> _levels;
+    node* _expired;
+    node* _free_nodes;
+    std::vector<std::unique_ptr<node[]>> _chunks;
+    size_t _size;
+
+    static unsigned count_trailing_zeros(uint64_t x)
+    {
+        unsigned n = 0;
+        #if defined(__GNUC__) || defined(__clang__)
+            n = static_cast<unsigned>(__builtin_ctzll(x));
+        #else
+            while ((x & 1u) == 0) { x >>= 1; ++n; }
+        #endif
+        return n;
+    }
+
+    static unsigned highest_bit(uint64_t x)
+    {
+        unsigned n = 0;
+        #if defined(__GNUC__) || defined(__clang__)
+            n = 63u - static_cast<unsigned>(__builtin_clzll(x));
+        #else
+            while (x >>= 1) ++n;
+        #endif
+        return n;
+    }
+
+    // Tick bits above the 6 bit group of the given level.
+    static uint64_t upper_bits(uint64_t tick, unsigned level)
+    {
+        const auto shift = slot_bits * (level + 1);
+        return shift >= 64 ? 0u : (tick >> shift) << shift;
+    }
+
+    static unsigned slot_of(uint64_t tick, unsigned level)
+    {
+        return static_cast<unsigned>((tick >> (slot_bits * level)) & (slot_count - 1));
+    }
+
+    uint64_t to_tick(const ssts::clock::time_point& timepoint) const
+    {
+        if (timepoint <= _origin)
+            return 0;
+
+        return static_cast<uint64_t>(std::chrono::ceil<Tick>(timepoint - _origin).count());
+    }
+
+    ssts::clock::time_point tick_to_time_point(uint64_t tick) const
+    {
+        return _origin + std::chrono::duration_cast<ssts::clock::duration>(Tick(tick));
+    }
+
+    static void push_front(node*& head, node* n)
+    {
+        n->prev = nullptr;
+        n->next = head;
+        if (head)
+            head->prev = n;
+        head = n;
+    }
+
+    static void remove(node*& head, node* n)
+    {
+        if (n->prev)
+            n->prev->next = n->next;
+        else
+            head = n->next;
+
+        if (n->next)
+            n->next->prev = n->prev;
+    }
+
+    void link(node* n)
+    {
+        if (n->tick <= _current_tick)
+        {
+            n->level = expired_level;
+            push_front(_expired, n);
+            return;
+        }
+
+        n->level = highest_bit(n->tick ^ _current_tick) / slot_bits;
+        n->slot = slot_of(n->tick, n->level);
+
+        auto& l = _levels[n->level];
+        push_front(l.slots[n->slot], n);
+        l.occupied |= uint64_t{ 1 } << n->slot;
+    }
+
+    void unlink(node* n)
+    {
+        if (n->level == detached_level)
+            return;
+
+        if (n->level == expired_level)
+        {
+            remove(_expired, n);
+            return;
+        }
+
+        auto& l = _levels[n->level];
+        remove(l.slots[n->slot], n);
+        if (!l.slots[n->slot])
+            l.occupied &= ~(uint64_t{ 1 } << n->slot);
+    }
+
+    void move_slot(wheel_level& l, unsigned slot, node*& destination)
+    {
+        for (node* n = l.slots[slot]; n; )
+        {
+            node* next = n->next;
+            push_front(destination, n);
+            n = next;
+        }
+
+        l.slots[slot] = nullptr;
+        l.occupied &= ~(uint64_t{ 1 } << slot);
+    }
+
+    /*
+     * Every value stored in level L shares the bits above group L with the current tick,
+     * and has group L greater than the current one. Moving the current tick to target_tick:
+     * - if target_tick has different upper bits, the whole level is expired;
+     * - otherwise slots between the current and the target group are expired,
+     *   and the target group slot holds values that must be cascaded relative to target_tick.
+     */
+    void advance(uint64_t target_tick)
+    {
+        node* cascading = nullptr;
+
+        for (unsigned level = 0; level < level_count; ++level)
+        {
+            auto& l = _levels[level];
+            if (l.occupied == 0)
+                continue;
+
+            if (upper_bits(_current_tick, level) != upper_bits(target_tick, level))
+            {
+                for (auto occupied = l.occupied; occupied != 0; occupied &= occupied - 1)
+                    move_slot(l, count_trailing_zeros(occupied), _expired);
+
+                continue;
+            }
+
+            const auto current_slot = slot_of(_current_tick, level);
+            const auto target_slot = slot_of(target_tick, level);
+            if (target_slot == current_slot)
+                continue;
+
+            const auto expired_mask = ((uint64_t{ 1 } << target_slot) - 1) & ~((uint64_t{ 2 } << current_slot) - 1);
+            for (auto occupied = l.occupied & expired_mask; occupied != 0; occupied &= occupied - 1)
+                move_slot(l, count_trailing_zeros(occupied), _expired);
+
+            if (l.occupied & (uint64_t{ 1 } << target_slot))
+                move_slot(l, target_slot, cascading);
+        }
+
+        _current_tick = target_tick;
+
+        while (cascading)
+        {
+            node* n = cascading;
+            cascading = n->next;
+            link(n);
+        }
+    }
+
+    node* allocate_node()
+    {
+        if (!_free_nodes)
+        {
+            _chunks.emplace_back(std::make_unique<node[]>(nodes_per_chunk));
+            for (size_t i = 0; i < nodes_per_chunk; ++i)
+                push_front(_free_nodes, &_chunks.back()[i]);
+        }
+
+        node* n = _free_nodes;
+        _free_nodes = n->next;
+        return n;
+    }
+
+    void release_node(node* n)
+    {
+        n->next = _free_nodes;
+        _free_nodes = n;
+    }
+};
+
+/*! \struct timing_wheel_queue_policy
+ *  \brief ssts::basic_task_scheduler policy selecting ssts::timing_wheel_queue.
+ *  \tparam Tick Duration of a wheel tick (i.e. the timer resolution).
+ */
+template<typename Tick = std::chrono::milliseconds>
+struct timing_wheel_queue_policy
+{
+    template<typename T>
+    using queue_type = timing_wheel_queue<T, Tick>;
+};
+
+}
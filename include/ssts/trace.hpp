@@ -0,0 +1,316 @@
+/*!
+ * \file trace.hpp
+ * \author Stefano Lusardi
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "clock.hpp"
+
+/*! \def SSTS_TRACE_BUFFER_CAPACITY
+ *  \brief Number of events kept by the trace ring buffer of each thread: older events are overwritten.
+ */
+#ifndef SSTS_TRACE_BUFFER_CAPACITY
+#define SSTS_TRACE_BUFFER_CAPACITY 65536
+#endif
+
+/*! \def SSTS_TRACE
+ *  \brief Record a task lifecycle event into the ssts::tracer, if SSTS_ENABLE_TRACING is defined (otherwise it compiles to nothing).
+ *
+ *  SSTS_ENABLE_TRACING must be defined consistently in all the translation units that include ssts headers
+ *  (e.g. with the SSTS_ENABLE_TRACING CMake option).
+ */
+#if defined(SSTS_ENABLE_TRACING)
+    #define SSTS_TRACE(event, hash) ::ssts::tracer::instance().record(::ssts::trace_event::event, static_cast<uint64_t>(hash))
+    #define SSTS_TRACE_THREAD_NAME(name) ::ssts::tracer::instance().set_thread_name(name)
+#else
+    #define SSTS_TRACE(event, hash) ((void)0)
+    #define SSTS_TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+namespace ssts
+{
+/*! \enum trace_event
+ *  \brief Task lifecycle events recorded by the ssts::tracer.
+ */
+enum class trace_event : uint8_t
+{
+    submit,     /*!< A task is submitted to an ssts::basic_task_scheduler (calling thread). */
+    insert,     /*!< A task is inserted into the scheduler time queue. */
+    expire,     /*!< A task time point is reached (i.e. the task is due). */
+    enqueue,    /*!< A task is queued into an ssts::task_pool. */
+    start,      /*!< A worker thread starts running a task. */
+    end,        /*!< A worker thread ends running a task. */
+    remove,     /*!< A task is removed by task_id. */
+    update      /*!< A task is updated by task_id (e.g. interval, slack, enabled). */
+};
+
+/*!
+ * \brief Get the name of a trace event.
+ * \param e Trace event.
+ * \return Event name, as shown in the Chrome trace.
+ */
+inline const char* to_string(trace_event e)
+{
+    switch (e)
+    {
+        case trace_event::submit: return "submit";
+        case trace_event::insert: return "insert";
+        case trace_event::expire: return "expire";
+        case trace_event::enqueue: return "enqueue";
+        case trace_event::start: return "start";
+        case trace_event::end: return "end";
+        case trace_event::remove: return "remove";
+        case trace_event::update: return "update";
+    }
+
+    return "unknown";
+}
+
+/*! \class tracer
+ *  \brief Process wide recorder of timestamped task lifecycle events, exported as Chrome trace JSON.
+ *
+ *  Each thread records its events into its own ring buffer of SSTS_TRACE_BUFFER_CAPACITY events:
+ *  recording takes a clock read and three relaxed stores, without any lock (the buffer is registered once, by set_thread_name or on the first event of the thread).
+ *  Recording never throws: events of a thread whose buffer cannot be allocated are dropped.
+ *  Buffers of exited threads are kept (and reused by new threads), so that their events can still be exported.
+ *  The trace can be written at any time: events being overwritten while it is written may be inconsistent.
+ *  The output can be loaded in chrome://tracing or https://ui.perfetto.dev, where task runs appear as slices on the worker threads.
+ */
+class tracer
+{
+    // Single writer ring buffer. The thread id and the event are packed in the same slot word.
+    class buffer
+    {
+    public:
+        void record(uint32_t tid, trace_event e, uint64_t hash) noexcept
+        {
+            const auto head = _head.load(std::memory_order_relaxed);
+            auto& slot = _slots[head % SSTS_TRACE_BUFFER_CAPACITY];
+            slot.time.store(ssts::clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+            slot.hash.store(hash, std::memory_order_relaxed);
+            slot.info.store((uint64_t{ tid } << 8) | static_cast<uint64_t>(e), std::memory_order_relaxed);
+            _head.store(head + 1, std::memory_order_release);
+        }
+
+        template<typename Function>
+        void for_each(Function&& f) const
+        {
+            const auto head = _head.load(std::memory_order_acquire);
+            const auto first = std::max(_tail.load(std::memory_order_relaxed), head > SSTS_TRACE_BUFFER_CAPACITY ? head - SSTS_TRACE_BUFFER_CAPACITY : 0);
+            for (auto i = first; i < head; ++i)
+            {
+                const auto& slot = _slots[i % SSTS_TRACE_BUFFER_CAPACITY];
+                const auto info = slot.info.load(std::memory_order_relaxed);
+                f(ssts::clock::rep{ slot.time.load(std::memory_order_relaxed) }, static_cast<uint32_t>(info >> 8), static_cast<trace_event>(info & 0xff), slot.hash.load(std::memory_order_relaxed));
+            }
+        }
+
+        void clear() { _tail.store(_head.load(std::memory_order_acquire), std::memory_order_relaxed); }
+
+    private:
+        struct slot
+        {
+            std::atomic<ssts::clock::rep> time{ 0 };
+            std::atomic<uint64_t> hash{ 0 };
+            std::atomic<uint64_t> info{ 0 };
+        };
+
+        std::unique_ptr<slot[]> _slots{ std::make_unique<slot[]>(SSTS_TRACE_BUFFER_CAPACITY) };
+        std::atomic<uint64_t> _head{ 0 };
+        std::atomic<uint64_t> _tail{ 0 };
+    };
+
+    // Owned by each thread that records events: gives its buffer back to the tracer when the thread exits.
+    struct thread_buffer
+    {
+        buffer* b = nullptr;
+        uint32_t tid = 0;
+
+        ~thread_buffer()
+        {
+            if (b)
+                tracer::instance().release(b);
+        }
+    };
+
+public:
+    /*!
+     * \brief Get the process wide tracer.
+     * \return ssts::tracer instance.
+     */
+    static tracer& instance()
+    {
+        static tracer t;
+        return t;
+    }
+
+    /*!
+     * \brief Record an event on the calling thread (see SSTS_TRACE).
+     * \param e Event.
+     * \param hash Task hash (std::hash of the task_id, 0 if none).
+     */
+    void record(trace_event e, uint64_t hash) noexcept
+    {
+        if (auto* local = try_local_buffer())
+            local->b->record(local->tid, e, hash);
+    }
+
+    /*!
+     * \brief Name the calling thread in the exported trace.
+     * \param name Thread name.
+     */
+    void set_thread_name(const std::string& name)
+    {
+        const auto tid = local_buffer().tid;
+        std::scoped_lock lock(_mtx);
+        _thread_names[tid] = name;
+    }
+
+    /*!
+     * \brief Discard all the recorded events.
+     */
+    void clear()
+    {
+        std::scoped_lock lock(_mtx);
+        for (const auto& b : _buffers)
+            b->clear();
+    }
+
+    /*!
+     * \brief Write the recorded events as Chrome trace JSON (Trace Event Format).
+     * \param os Output stream.
+     *
+     * Task runs are written as begin/end slices, the other events as instant events with the task hash in their arguments.
+     * Timestamps are ssts::clock time points, in microseconds.
+     */
+    void write_chrome_trace(std::ostream& os) const
+    {
+        std::scoped_lock lock(_mtx);
+        os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+        bool is_first = true;
+        auto separator = [&os, &is_first] { os << (is_first ? "\n" : ",\n"); is_first = false; };
+
+        for (const auto& [tid, name] : _thread_names)
+        {
+            separator();
+            os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"name\":\"";
+            write_json_escaped(os, name);
+            os << "\"}}";
+        }
+
+        for (const auto& b : _buffers)
+        {
+            b->for_each([&os, &separator](ssts::clock::rep time, uint32_t tid, trace_event e, uint64_t hash)
+            {
+                const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(ssts::clock::duration{ time }).count();
+                const auto* phase = e == trace_event::start ? "B" : e == trace_event::end ? "E" : "i";
+                const auto* name = e == trace_event::start || e == trace_event::end ? "task" : to_string(e);
+
+                separator();
+                os << "{\"name\":\"" << name << "\",\"cat\":\"ssts\",\"ph\":\"" << phase << "\"";
+                if (*phase == 'i')
+                    os << ",\"s\":\"t\"";
+                os << ",\"ts\":" << ns / 1000 << '.' << std::to_string(1000 + ns % 1000).substr(1)
+                   << ",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"task\":\"" << hash << "\"}}";
+            });
+        }
+
+        os << "\n]}\n";
+    }
+
+    /*!
+     * \brief Write the recorded events as Chrome trace JSON to a file.
+     * \param path Output file path.
+     * \return bool indicating if the file has been written.
+     */
+    bool dump_chrome_trace(const std::string& path) const
+    {
+        std::ofstream file(path);
+        if (!file)
+            return false;
+
+        write_chrome_trace(file);
+        return static_cast<bool>(file);
+    }
+
+private:
+    mutable std::mutex _mtx;
+    std::vector<std::unique_ptr<buffer>> _buffers;
+    std::vector<buffer*> _free_buffers;
+    std::unordered_map<uint32_t, std::string> _thread_names;
+    uint32_t _next_tid = 1;
+
+    tracer() = default;
+
+    thread_buffer& local_buffer()
+    {
+        static thread_local thread_buffer local;
+        if (!local.b)
+        {
+            std::scoped_lock lock(_mtx);
+            local.tid = _next_tid++;
+            if (_free_buffers.empty())
+            {
+                _buffers.push_back(std::make_unique<buffer>());
+                local.b = _buffers.back().get();
+            }
+            else
+            {
+                local.b = _free_buffers.back();
+                _free_buffers.pop_back();
+            }
+        }
+
+        return local;
+    }
+
+    // Events must never throw out of record(), which is called by worker threads (and from noexcept functions):
+    // if the buffer of the calling thread cannot be registered (e.g. std::bad_alloc), the event is dropped and registration is retried on the next one.
+    thread_buffer* try_local_buffer() noexcept
+    {
+        try
+        {
+            return &local_buffer();
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+
+    // Thread names are user supplied: quotes, backslashes and control characters are escaped, so that they cannot corrupt the JSON.
+    static void write_json_escaped(std::ostream& os, const std::string& s)
+    {
+        static constexpr char hex_digits[] = "0123456789abcdef";
+        for (const char c : s)
+        {
+            if (c == '"' || c == '\\')
+                os << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20)
+                os << "\\u00" << hex_digits[(c >> 4) & 0xf] << hex_digits[c & 0xf];
+            else
+                os << c;
+        }
+    }
+
+    void release(buffer* b)
+    {
+        std::scoped_lock lock(_mtx);
+        _free_buffers.push_back(b);
+    }
+};
+
+}
@@ -0,0 +1,143 @@
+/*!
+ * \file wait_strategy.hpp
+ * \author Stefano Lusardi
+ */
+
+#pragma once
+
+#include <chrono>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+#endif
+
+#include "clock.hpp"
+
+namespace ssts
+{
+/*! \struct wait_strategy
+ *  \brief How a thread waits for work: bounded spinning, then yielding, then parking on a condition variable.
+ *
+ *  Parking costs a futex wake and a context switch on each handoff (tens of microseconds),
+ *  spinning trades CPU time for lower wake-up latency and is only worth it on dedicated cores.
+ *  The default strategy parks immediately.
+ */
+struct wait_strategy
+{
+    /*! Time spent busy waiting with CPU pause instructions before yielding. */
+    std::chrono::nanoseconds spin_duration{ 0 };
+
+    /*! Time spent calling std::this_thread::yield after spinning, before parking. */
+    std::chrono::nanoseconds yield_duration{ 0 };
+
+    /*!
+     * \brief Check if the strategy busy waits at all.
+     * \return bool false if the thread parks immediately.
+     */
+    bool is_spinning() const { return spin_duration.count() > 0 || yield_duration.count() > 0; }
+
+    /*!
+     * \brief Park immediately (default).
+     * \return ssts::wait_strategy that never spins.
+     */
+    static wait_strategy park() { return wait_strategy{}; }
+
+    /*!
+     * \brief Spin, then yield, then park.
+     * \param spin Time spent spinning.
+     * \param yield Time spent yielding after spinning.
+     * \return ssts::wait_strategy with the given durations.
+     */
+    static wait_strategy spin_then_park(std::chrono::nanoseconds spin, std::chrono::nanoseconds yield = std::chrono::nanoseconds{ 0 })
+    {
+        return wait_strategy{ spin, yield };
+    }
+};
+
+/*!
+ * \brief Hint the CPU that the calling thread is busy waiting (pause on x86, yield on ARM).
+ */
+inline void cpu_relax()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__aarch64__) || defined(__arm__))
+    asm volatile("yield");
+#endif
+}
+
+namespace detail
+{
+// The clock is read once every spin_batch iterations, as reading it costs more than a pause instruction.
+constexpr unsigned spin_batch = 16;
+}
+
+/*!
+ * \brief Busy wait until a condition holds, following the spin and yield phases of a wait strategy.
+ * \param strategy Wait strategy.
+ * \param is_ready Predicate checked between pause instructions.
+ * \return bool indicating if is_ready() returned true: if false, the caller is expected to park.
+ */
+template<typename Predicate>
+bool spin_wait(const ssts::wait_strategy& strategy, Predicate&& is_ready)
+{
+    if (!strategy.is_spinning())
+        return is_ready();
+
+    const auto start = ssts::clock::now();
+    for (auto now = start; now - start < strategy.spin_duration; now = ssts::clock::now())
+    {
+        for (unsigned n = 0; n < detail::spin_batch; ++n)
+        {
+            if (is_ready())
+                return true;
+
+            cpu_relax();
+        }
+    }
+
+    const auto yield_end = ssts::clock::now() + strategy.yield_duration;
+    do
+    {
+        if (is_ready())
+            return true;
+
+        std::this_thread::yield();
+    }
+    while (ssts::clock::now() < yield_end);
+
+    return is_ready();
+}
+
+/*!
+ * \brief Busy wait until a time point, unless a condition holds before.
+ * \param strategy Wait strategy: the thread yields until spin_duration before timepoint, then spins.
+ * \param timepoint Time point to wait for. It should be at most spin_duration + yield_duration in the future.
+ * \param is_interrupted Predicate that stops waiting.
+ * \return bool true if timepoint has been reached, false if is_interrupted() returned true before.
+ */
+template<typename Predicate>
+bool spin_wait_until(const ssts::wait_strategy& strategy, const ssts::clock::time_point& timepoint, Predicate&& is_interrupted)
+{
+    for (auto now = ssts::clock::now(); now < timepoint; now = ssts::clock::now())
+    {
+        if (is_interrupted())
+            return false;
+
+        if (timepoint - now > strategy.spin_duration)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        for (unsigned n = 0; n < detail::spin_batch; ++n)
+            cpu_relax();
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+#include <ssts/task_scheduler.hpp>
+
+namespace ssts
+{
+
+// A CPU the test process is allowed to run on.
+std::optional<unsigned int> allowed_cpu()
+{
+    const auto cpus = ssts::get_thread_affinity();
+    if (cpus.empty())
+        return std::nullopt;
+
+    return cpus.back();
+}
+
+TEST(Affinity, ParseCpuList)
+{
+    EXPECT_EQ(ssts::parse_cpu_list("0"), std::vector<unsigned int>{ 0 });
+    EXPECT_EQ(ssts::parse_cpu_list("0-3,8,10-11\n"), (std::vector<unsigned int>{ 0, 1, 2, 3, 8, 10, 11 }));
+    EXPECT_EQ(ssts::parse_cpu_list(""), std::vector<unsigned int>{});
+    EXPECT_EQ(ssts::parse_cpu_list("a-b"), std::vector<unsigned int>{});
+}
+
+TEST(Affinity, NumaNodeCount)
+{
+    EXPECT_GE(ssts::numa_node_count(), 1u);
+    EXPECT_TRUE(ssts::numa_node_cpus(1u << 20).empty());
+}
+
+TEST(Affinity, PinnedWorkers)
+{
+    const auto cpu = allowed_cpu();
+    if (!cpu)
+        GTEST_SKIP() << "Thread affinity is not available on this platform";
+
+    for (auto mode : { ssts::pool_mode::shared_queue, ssts::pool_mode::work_stealing })
+    {
+        ssts::pool_options options;
+        options.num_threads = 2;
+        options.mode = mode;
+        options.worker_cpus = { cpu.value() };
+        ssts::task_pool tp(options);
+
+        std::vector<ssts::future<std::vector<unsigned int>>> affinities;
+        for (auto n = 0; n < 8; ++n)
+            affinities.push_back(tp.submit([]{ return ssts::get_thread_affinity(); }));
+
+        for (auto& a : affinities)
+            EXPECT_EQ(a.get(), std::vector<unsigned int>{ cpu.value() });
+
+        tp.stop();
+    }
+}
+
+TEST(Affinity, NumaNodeWorkers)
+{
+    const auto node_cpus = ssts::numa_node_cpus(0);
+    if (node_cpus.empty())
+        GTEST_SKIP() << "NUMA topology is not available on this platform";
+
+    ssts::pool_options options;
+    options.num_threads = 2;
+    options.numa_node = 0;
+    ssts::task_pool tp(options);
+
+    for (auto cpu : tp.submit([]{ return ssts::get_thread_affinity(); }).get())
+        EXPECT_NE(std::find(node_cpus.begin(), node_cpus.end(), cpu), node_cpus.end());
+
+    tp.stop();
+}
+
+TEST(Affinity, PinnedScheduler)
+{
+    const auto cpu = allowed_cpu();
+    if (!cpu)
+        GTEST_SKIP() << "Thread affinity is not available on this platform";
+
+    ssts::scheduler_options options;
+    options.pool.num_threads = 2;
+    options.pool.worker_cpus = { cpu.value() };
+    options.scheduler_cpus = { cpu.value() };
+    ssts::task_scheduler s(options);
+    s.start();
+
+    std::atomic_uint pinned_count = 0;
+    s.every(10ms, [&pinned_count, cpu]{ if (ssts::get_thread_affinity() == std::vector<unsigned int>{ cpu.value() }) ++pinned_count; });
+
+    std::this_thread::sleep_for(200ms);
+    s.stop();
+    EXPECT_GE(pinned_count, 5u);
+}
+
+}
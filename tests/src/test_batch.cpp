@@ -0,0 +1,96 @@
+#include "scheduler_fixture.hpp"
+#include <vector>
+
+namespace ssts
+{
+
+class Batch : public SchedulerTest { };
+
+TEST_F(Batch, Unsorted)
+{
+    std::atomic_uint count = 0;
+    InitScheduler(2u);
+
+    std::vector<ssts::batch_task> tasks;
+    const auto now = ssts::clock::now();
+    for (auto n = 0; n < 100; ++n)
+        tasks.push_back({ now + 50ms + ((n * 37) % 100) * 1ms, [&count]{ ++count; } });
+
+    s->post_batch(tasks.begin(), tasks.end());
+    EXPECT_EQ(get_size(), 100u);
+    Sleep(200ms);
+
+    EXPECT_EQ(count, 100u);
+    EXPECT_EQ(get_size(), 0u);
+}
+
+TEST_F(Batch, Presorted)
+{
+    std::mutex order_mtx;
+    std::vector<int> order;
+    InitScheduler(1u);
+
+    std::vector<ssts::batch_task> tasks;
+    const auto now = ssts::clock::now();
+    for (auto n = 0; n < 100; ++n)
+        tasks.push_back({ now + 50ms + (n / 10) * 5ms, [n, &order, &order_mtx]{ std::scoped_lock lock(order_mtx); order.push_back(n); } });
+
+    s->post_batch(tasks.begin(), tasks.end(), true);
+    Sleep(200ms);
+
+    // A single worker runs tasks in time point order, and tasks sharing a time point in insertion order.
+    ASSERT_EQ(order.size(), 100u);
+    EXPECT_TRUE(std::is_sorted(order.begin(), order.end()));
+}
+
+TEST_F(Batch, TaskIdAndInterval)
+{
+    std::atomic_uint count = 0;
+    InitScheduler(2u);
+
+    std::vector<ssts::batch_task> tasks;
+    tasks.push_back({ ssts::clock::now(), [&count]{ ++count; }, "every_id"s, 20ms });
+    tasks.push_back({ ssts::clock::now() + 1h, []{ }, "in_id"s });
+    s->post_batch(tasks.begin(), tasks.end());
+
+    EXPECT_TRUE(s->is_scheduled("every_id"));
+    EXPECT_TRUE(s->is_scheduled("in_id"));
+    Sleep(100ms);
+
+    EXPECT_TRUE(s->is_scheduled("every_id"));
+    EXPECT_GE(count, 5u);
+    EXPECT_TRUE(s->remove_task("every_id"));
+    EXPECT_TRUE(s->remove_task("in_id"));
+}
+
+TEST_F(Batch, DuplicatesNotAllowed)
+{
+    InitScheduler(2u);
+    s->set_duplicate_allowed(false);
+    s->post_in("task_id"s, 1h, []{ });
+
+    std::vector<ssts::batch_task> tasks;
+    for (auto n = 0; n < 4; ++n)
+        tasks.push_back({ ssts::clock::now() + 1h, []{ }, "task_id"s });
+    tasks.push_back({ ssts::clock::now() + 1h, []{ }, "other_id"s });
+
+    s->post_batch(tasks.begin(), tasks.end());
+    EXPECT_EQ(get_size(), 2u);
+}
+
+TEST_F(Batch, EarlierTaskWakesScheduler)
+{
+    std::atomic_uint count = 0;
+    InitScheduler(2u);
+    s->post_in(1h, []{ });
+    Sleep(50ms);
+
+    std::vector<ssts::batch_task> tasks;
+    tasks.push_back({ ssts::clock::now() + 50ms, [&count]{ ++count; } });
+    s->post_batch(tasks.begin(), tasks.end());
+    Sleep(100ms);
+
+    EXPECT_EQ(count, 1u);
+}
+
+}
@@ -0,0 +1,74 @@
+#include "scheduler_fixture.hpp"
+#include <vector>
+
+namespace ssts
+{
+
+class Dispatch : public SchedulerTest { };
+
+class PoolBatch : public ::testing::TestWithParam<ssts::pool_mode> { };
+
+TEST_P(PoolBatch, PostBatch)
+{
+    std::atomic_uint count = 0;
+    {
+        ssts::pool_options options;
+        options.num_threads = 4;
+        options.mode = GetParam();
+        ssts::task_pool tp(options);
+        std::vector<std::function<void()>> tasks(1000, [&count]{ ++count; });
+        tp.post_batch(tasks.begin(), tasks.end());
+
+        std::this_thread::sleep_for(500ms);
+        tp.stop();
+    }
+    EXPECT_EQ(count, 1000u);
+}
+
+TEST_P(PoolBatch, WakesIdleWorkers)
+{
+    // Every task blocks until all the tasks of the batch are running: all the workers must be woken up.
+    constexpr unsigned n_workers = 4;
+    std::atomic_uint running = 0;
+    std::atomic_uint count = 0;
+    {
+        ssts::pool_options options;
+        options.num_threads = n_workers;
+        options.mode = GetParam();
+        ssts::task_pool tp(options);
+        std::this_thread::sleep_for(100ms);
+
+        std::vector<std::function<void()>> tasks(n_workers, [&]
+        {
+            ++running;
+            const auto deadline = ssts::clock::now() + 2s;
+            while (running < n_workers && ssts::clock::now() < deadline)
+                std::this_thread::yield();
+            ++count;
+        });
+        tp.post_batch(tasks.begin(), tasks.end());
+
+        std::this_thread::sleep_for(500ms);
+        tp.stop();
+    }
+    EXPECT_EQ(running, n_workers);
+    EXPECT_EQ(count, n_workers);
+}
+
+INSTANTIATE_TEST_SUITE_P(Pool, PoolBatch, ::testing::Values(ssts::pool_mode::shared_queue, ssts::pool_mode::work_stealing));
+
+TEST_F(Dispatch, ManyTasksInSameTick)
+{
+    std::atomic_uint count = 0;
+    InitScheduler(4u);
+
+    const auto timepoint = ssts::clock::now() + 50ms;
+    for (auto n = 0; n < 10'000; ++n)
+        s->post_at(ssts::clock::time_point(timepoint), [&count]{ ++count; });
+
+    Sleep(200ms);
+    EXPECT_EQ(count, 10'000u);
+    EXPECT_EQ(get_size(), 0u);
+}
+
+}
@@ -27,4 +27,24 @@ TEST_F(Duplicated, DuplicatesAllowed)
     EXPECT_EQ(get_size(), 8u);
 }
 
+TEST_F(Duplicated, RemoveDuplicatesOneByOne)
+{
+    n_tasks = 4;
+    InitScheduler(4u);
+    force_duplicate_allowed(true);
+
+    StartAllTasksIn(1min);
+    EXPECT_EQ(get_size(), 4u);
+
+    for (auto n = n_tasks; n > 0; --n)
+    {
+        EXPECT_TRUE(s->is_scheduled("duplicated_id"));
+        EXPECT_TRUE(s->remove_task("duplicated_id"));
+        EXPECT_EQ(get_size(), n - 1);
+    }
+
+    EXPECT_FALSE(s->is_scheduled("duplicated_id"));
+    EXPECT_FALSE(s->remove_task("duplicated_id"));
+}
+
 }
@@ -0,0 +1,159 @@
+#include "gtest/gtest.h"
+#include <ssts/task_scheduler.hpp>
+
+namespace ssts
+{
+
+class Edf : public ::testing::TestWithParam<ssts::queue_order>
+{
+protected:
+    void record(char c)
+    {
+        std::scoped_lock lock(mtx);
+        order.push_back(c);
+    }
+
+    std::string get_order()
+    {
+        std::scoped_lock lock(mtx);
+        return order;
+    }
+
+    std::mutex mtx;
+    std::string order;
+};
+
+TEST_P(Edf, MostOverdueFirst)
+{
+    ssts::pool_options options;
+    options.num_threads = 1;
+    options.order = GetParam();
+    ssts::task_scheduler s(options);
+    s.start();
+
+    // Keep the only worker busy while late tasks are dispatched 20ms apart: relative to the test start,
+    // a is due at +10ms, b at -10ms and c at -20ms.
+    std::promise<void> release;
+    s.post_in(0ms, [f = release.get_future().share()]{ f.wait(); });
+    std::this_thread::sleep_for(20ms);
+
+    s.post_at(ssts::clock::now() - 10ms, [this]{ record('a'); });
+    std::this_thread::sleep_for(20ms);
+    s.post_at(ssts::clock::now() - 50ms, [this]{ record('b'); });
+    std::this_thread::sleep_for(20ms);
+    s.post_at(ssts::clock::now() - 80ms, [this]{ record('c'); });
+    std::this_thread::sleep_for(20ms);
+
+    release.set_value();
+    std::this_thread::sleep_for(50ms);
+    s.stop();
+
+    EXPECT_EQ(get_order(), GetParam() == ssts::queue_order::fifo ? "abc" : "cba");
+}
+
+TEST_P(Edf, PoolTasksInQueueOrder)
+{
+    ssts::pool_options options;
+    options.num_threads = 1;
+    options.order = GetParam();
+    ssts::task_pool tp(options);
+
+    std::promise<void> release;
+    tp.post([f = release.get_future().share()]{ f.wait(); });
+    std::this_thread::sleep_for(20ms);
+
+    for (auto c : { 'a', 'b', 'c', 'd' })
+        tp.post([this, c]{ record(c); });
+
+    release.set_value();
+    tp.submit([]{ }).get();
+    tp.stop();
+
+    EXPECT_EQ(get_order(), "abcd");
+}
+
+TEST_P(Edf, StarvationProtectionUsesOldestTask)
+{
+    ssts::pool_options options;
+    options.num_threads = 1;
+    options.order = GetParam();
+    options.starvation_timeout = 50ms;
+    ssts::task_scheduler s(options);
+    s.start();
+
+    std::promise<void> release;
+    s.post_in(0ms, [f = release.get_future().share()]{ f.wait(); });
+    std::this_thread::sleep_for(20ms);
+
+    // The old low priority task has the latest deadline: it is starved unless the oldest task of its queue is checked,
+    // rather than the one with the earliest deadline.
+    auto o = s.at(ssts::priority::low, ssts::clock::now(), [this]{ record('o'); });
+    std::this_thread::sleep_for(100ms);
+    auto h = s.at(ssts::priority::high, ssts::clock::now() - 10ms, [this]{ record('h'); });
+    std::this_thread::sleep_for(20ms);
+    auto e1 = s.at(ssts::priority::low, ssts::clock::now() - 1s, [this]{ record('e'); });
+    auto e2 = s.at(ssts::priority::low, ssts::clock::now() - 1s, [this]{ record('e'); });
+    std::this_thread::sleep_for(100ms);
+
+    release.set_value();
+    e2.wait();
+    std::this_thread::sleep_for(20ms);
+    s.stop();
+
+    EXPECT_EQ(get_order(), "ohee");
+}
+
+INSTANTIATE_TEST_SUITE_P(Orders, Edf, ::testing::Values(ssts::queue_order::fifo, ssts::queue_order::earliest_deadline_first));
+
+TEST(Lateness, ReportedPerTask)
+{
+    std::mutex mtx;
+    std::vector<std::pair<size_t, ssts::clock::duration>> reports;
+
+    ssts::pool_options options;
+    options.num_threads = 1;
+    options.lateness_callback = [&mtx, &reports](size_t task_hash, ssts::clock::duration lateness)
+    {
+        std::scoped_lock lock(mtx);
+        reports.emplace_back(task_hash, lateness);
+    };
+
+    ssts::task_scheduler s(options);
+    s.start();
+    s.post_in("task_id"s, 10ms, []{ });
+    s.post_at(ssts::clock::now() - 100ms, []{ });
+    std::this_thread::sleep_for(100ms);
+    s.stop();
+
+    std::scoped_lock lock(mtx);
+    ASSERT_EQ(reports.size(), 2u);
+
+    // The task scheduled in the past is reported first, with its full lateness.
+    EXPECT_EQ(reports[0].first, 0u);
+    EXPECT_GE(reports[0].second, 100ms);
+    EXPECT_EQ(reports[1].first, std::hash<std::string>{}("task_id"));
+    EXPECT_GE(reports[1].second, 0ms);
+    EXPECT_LT(reports[1].second, 100ms);
+}
+
+TEST(Lateness, WorkStealingLocalTasks)
+{
+    std::atomic_uint count = 0;
+    ssts::pool_options options;
+    options.num_threads = 2;
+    options.mode = ssts::pool_mode::work_stealing;
+    options.lateness_callback = [&count](size_t, ssts::clock::duration lateness)
+    {
+        if (lateness >= 0ms && lateness < 1s)
+            ++count;
+    };
+
+    ssts::task_pool tp(options);
+    tp.submit([&tp]{ for (auto n = 0; n < 9; ++n) tp.post([]{ }); }).get();
+    std::this_thread::sleep_for(100ms);
+    tp.stop();
+
+    EXPECT_EQ(count, 10u);
+}
+
+}
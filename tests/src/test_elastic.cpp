@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+#include <ssts/task_scheduler.hpp>
+
+namespace ssts
+{
+
+ssts::pool_options elastic_options(unsigned min_threads, unsigned max_threads)
+{
+    ssts::pool_options options;
+    options.num_threads = min_threads;
+    options.max_threads = max_threads;
+    options.max_queue_wait = 20ms;
+    options.idle_timeout = 300ms;
+    return options;
+}
+
+TEST(Elastic, FixedByDefault)
+{
+    ssts::pool_options options;
+    options.num_threads = 2;
+    ssts::task_pool tp(options);
+    EXPECT_EQ(tp.thread_count(), 2u);
+
+    for (auto n = 0; n < 4; ++n)
+        tp.post([]{ std::this_thread::sleep_for(100ms); });
+
+    std::this_thread::sleep_for(150ms);
+    EXPECT_EQ(tp.thread_count(), 2u);
+    tp.stop();
+}
+
+TEST(Elastic, GrowsWhenTasksBlock)
+{
+    std::atomic_uint count = 0;
+    ssts::task_pool tp(elastic_options(1, 4));
+    EXPECT_EQ(tp.thread_count(), 1u);
+
+    // Four blocking tasks: without new threads they would take 4 * 300ms.
+    for (auto n = 0; n < 4; ++n)
+        tp.post([&count]{ std::this_thread::sleep_for(300ms); ++count; });
+
+    std::this_thread::sleep_for(200ms);
+    EXPECT_EQ(tp.thread_count(), 4u);
+
+    std::this_thread::sleep_for(400ms);
+    EXPECT_EQ(count, 4u);
+    tp.stop();
+}
+
+TEST(Elastic, NeverAboveMaxThreads)
+{
+    ssts::task_pool tp(elastic_options(1, 3));
+    for (auto n = 0; n < 10; ++n)
+        tp.post([]{ std::this_thread::sleep_for(200ms); });
+
+    std::this_thread::sleep_for(300ms);
+    EXPECT_EQ(tp.thread_count(), 3u);
+    tp.stop();
+}
+
+TEST(Elastic, ShrinksWhenIdle)
+{
+    std::atomic_uint count = 0;
+    ssts::task_pool tp(elastic_options(1, 4));
+    for (auto n = 0; n < 4; ++n)
+        tp.post([]{ std::this_thread::sleep_for(200ms); });
+
+    std::this_thread::sleep_for(150ms);
+    EXPECT_GT(tp.thread_count(), 1u);
+
+    std::this_thread::sleep_for(1s);
+    EXPECT_EQ(tp.thread_count(), 1u);
+
+    // Retired slots are reused.
+    for (auto n = 0; n < 4; ++n)
+        tp.post([&count]{ std::this_thread::sleep_for(200ms); ++count; });
+
+    std::this_thread::sleep_for(150ms);
+    EXPECT_GT(tp.thread_count(), 1u);
+    std::this_thread::sleep_for(500ms);
+    EXPECT_EQ(count, 4u);
+    tp.stop();
+}
+
+TEST(Elastic, Scheduler)
+{
+    std::atomic_uint count = 0;
+    ssts::task_scheduler s(elastic_options(1, 8));
+    s.start();
+
+    // A periodic job that blocks longer than its interval would delay every other task of a fixed single thread pool.
+    s.every("blocking"s, 50ms, []{ std::this_thread::sleep_for(200ms); });
+    s.every("counter"s, 50ms, [&count]{ ++count; });
+
+    std::this_thread::sleep_for(1s);
+    s.stop();
+
+    EXPECT_GE(count, 10u);
+}
+
+}
@@ -0,0 +1,75 @@
+#include "scheduler_fixture.hpp"
+
+namespace ssts
+{
+
+class FirePath : public SchedulerTest
+{
+protected:
+    struct lifetime_counters
+    {
+        std::atomic_uint copies = 0;
+        std::atomic_uint moves = 0;
+        std::atomic_uint alive = 0;
+        std::atomic_uint runs = 0;
+    };
+
+    // Callable that counts its copies, moves, live instances and runs.
+    struct tracked_callable
+    {
+        explicit tracked_callable(lifetime_counters& c) : counters{ &c } { ++counters->alive; }
+        tracked_callable(const tracked_callable& other) : counters{ other.counters } { ++counters->copies; ++counters->alive; }
+        tracked_callable(tracked_callable&& other) noexcept : counters{ other.counters } { ++counters->moves; ++counters->alive; }
+        tracked_callable& operator=(const tracked_callable&) = delete;
+        tracked_callable& operator=(tracked_callable&&) = delete;
+        ~tracked_callable() { --counters->alive; }
+
+        void operator()() const { ++counters->runs; }
+
+        lifetime_counters* counters;
+    };
+
+    lifetime_counters c;
+};
+
+TEST_F(FirePath, OneShotCallableMovedNotCopied)
+{
+    InitScheduler(2u);
+    s->post_in(100ms, tracked_callable{ c });
+
+    // The callable is moved into the scheduled task: neither the scheduler thread nor the pool copy or move it when it fires.
+    EXPECT_EQ(c.copies, 0u);
+    const unsigned int moves = c.moves;
+    EXPECT_EQ(c.alive, 1u);
+
+    Sleep(100ms);
+
+    EXPECT_EQ(c.runs, 1u);
+    EXPECT_EQ(c.copies, 0u);
+    EXPECT_EQ(c.moves, moves);
+
+    // The task is destroyed once it has run.
+    EXPECT_EQ(c.alive, 0u);
+}
+
+TEST_F(FirePath, RecursiveCallableSharedOnRearm)
+{
+    InitScheduler(2u);
+    s->every("task_id"s, 10ms, tracked_callable{ c });
+    const unsigned int copies = c.copies;
+    const unsigned int moves = c.moves;
+
+    Sleep(50ms);
+
+    // Each run shares the callable of the scheduled task: it is never copied, moved or destroyed when the task is re-armed.
+    EXPECT_GE(c.runs, 5u);
+    EXPECT_EQ(c.copies, copies);
+    EXPECT_EQ(c.moves, moves);
+    EXPECT_EQ(c.alive, 1u);
+
+    s->remove_task("task_id");
+    Sleep(10ms);
+    EXPECT_EQ(c.alive, 0u);
+}
+
+}
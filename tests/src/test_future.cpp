@@ -0,0 +1,115 @@
+#include "scheduler_fixture.hpp"
+#include <ssts/future.hpp>
+
+namespace ssts
+{
+
+class Future : public SchedulerTest { };
+
+TEST(Promise, SetValueBeforeGet)
+{
+    ssts::promise<int> p;
+    auto f = p.get_future();
+    p.set_value(42);
+
+    EXPECT_TRUE(f.is_ready());
+    EXPECT_EQ(f.get(), 42);
+    EXPECT_FALSE(f.valid());
+}
+
+TEST(Promise, BlockingGet)
+{
+    ssts::promise<std::string> p;
+    auto f = p.get_future();
+
+    std::thread producer([&p]{ std::this_thread::sleep_for(100ms); p.set_value("ssts"); });
+    EXPECT_EQ(f.get(), "ssts");
+    producer.join();
+}
+
+TEST(Promise, BrokenPromise)
+{
+    ssts::future<void> f;
+    {
+        ssts::promise<void> p;
+        f = p.get_future();
+    }
+    EXPECT_THROW(f.get(), std::future_error);
+}
+
+TEST(Promise, SetValueTwice)
+{
+    ssts::promise<int> p;
+    auto f = p.get_future();
+    p.set_value(1);
+
+    EXPECT_THROW(p.set_value(2), std::future_error);
+    EXPECT_EQ(f.get(), 1);
+}
+
+TEST(Promise, SetExceptionAfterValue)
+{
+    ssts::promise<int> p;
+    auto f = p.get_future();
+    p.set_value(1);
+
+    EXPECT_THROW(p.set_exception(std::make_exception_ptr(std::runtime_error("error"))), std::future_error);
+    EXPECT_EQ(f.get(), 1);
+}
+
+TEST(Promise, ThenAfterReady)
+{
+    ssts::promise<int> p;
+    auto f = p.get_future();
+    p.set_value(1);
+
+    auto next = f.then([](int v){ return v + 1; }).then([](int v){ return std::to_string(v); });
+    EXPECT_EQ(next.get(), "2");
+}
+
+TEST(Promise, ThenForwardsException)
+{
+    ssts::promise<int> p;
+    auto f = p.get_future();
+    bool is_continuation_invoked = false;
+    auto next = f.then([&is_continuation_invoked](int v){ is_continuation_invoked = true; return v; });
+
+    p.set_exception(std::make_exception_ptr(std::runtime_error("error")));
+    EXPECT_THROW(next.get(), std::runtime_error);
+    EXPECT_FALSE(is_continuation_invoked);
+}
+
+TEST(PoolFuture, ThenRunsOnWorker)
+{
+    ssts::task_pool tp(2);
+
+    std::thread::id task_thread_id;
+    auto f = tp.submit([&task_thread_id]{ std::this_thread::sleep_for(100ms); task_thread_id = std::this_thread::get_id(); return 20; });
+    auto next = f.then([&task_thread_id](int v){ EXPECT_EQ(task_thread_id, std::this_thread::get_id()); return v * 2 + 2; });
+
+    EXPECT_EQ(next.get(), 42);
+    tp.stop();
+}
+
+TEST_F(Future, SubmitIn)
+{
+    InitScheduler(2u);
+    auto f = s->submit_in(100ms, [](auto x, auto y){ return x + y; }, 40, 2);
+
+    std::atomic_bool is_continuation_invoked = false;
+    auto next = f.then([&is_continuation_invoked](int v){ is_continuation_invoked = true; return v; });
+
+    EXPECT_EQ(next.get(), 42);
+    EXPECT_TRUE(is_continuation_invoked);
+}
+
+TEST_F(Future, RemovedTaskBreaksPromise)
+{
+    InitScheduler(2u);
+    auto f = s->submit_in("task_id"s, 1s, []{ return 42; });
+    s->remove_task("task_id");
+
+    EXPECT_THROW(f.get(), std::future_error);
+}
+
+}
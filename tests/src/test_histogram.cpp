@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+#include <ssts/task_scheduler.hpp>
+
+namespace ssts
+{
+
+TEST(LatencyHistogram, Empty)
+{
+    ssts::latency_histogram h;
+    const auto s = h.summary();
+    EXPECT_EQ(s.count, 0u);
+    EXPECT_EQ(s.p99, ssts::clock::duration{ 0 });
+    EXPECT_EQ(s.max, ssts::clock::duration{ 0 });
+}
+
+TEST(LatencyHistogram, SmallValuesAreExact)
+{
+    ssts::latency_histogram h;
+    for (int n = 0; n < 32; ++n)
+        h.record(std::chrono::nanoseconds(n));
+
+    EXPECT_EQ(h.count(), 32u);
+    EXPECT_EQ(h.percentile(0.5), std::chrono::nanoseconds(15));
+    EXPECT_EQ(h.percentile(1.0), std::chrono::nanoseconds(31));
+}
+
+TEST(LatencyHistogram, Percentiles)
+{
+    ssts::latency_histogram h;
+    for (int n = 1; n <= 10'000; ++n)
+        h.record(std::chrono::microseconds(n));
+
+    // Percentiles are bucket upper bounds: at most about 3% above the exact value.
+    auto expect_near = [](ssts::clock::duration actual, ssts::clock::duration expected)
+    {
+        EXPECT_GE(actual, expected);
+        EXPECT_LE(actual, expected + expected / 32);
+    };
+
+    const auto s = h.summary();
+    EXPECT_EQ(s.count, 10'000u);
+    expect_near(s.mean, std::chrono::nanoseconds(5'000'500));
+    expect_near(s.p50, 5ms);
+    expect_near(s.p99, 9900us);
+    expect_near(s.p999, 9990us);
+    EXPECT_EQ(s.max, 10ms);
+}
+
+TEST(LatencyHistogram, OutOfRange)
+{
+    ssts::latency_histogram h;
+    h.record(-1ms);
+    h.record(1h);
+
+    EXPECT_EQ(h.percentile(0.5), ssts::clock::duration{ 0 });
+    EXPECT_GT(h.percentile(1.0), 10min);
+    EXPECT_LT(h.percentile(1.0), 1h);
+}
+
+TEST(LatencyHistogram, Merge)
+{
+    ssts::latency_histogram a;
+    ssts::latency_histogram b;
+    for (int n = 0; n < 150; ++n)
+        a.record(1ms);
+    for (int n = 0; n < 100; ++n)
+        b.record(2ms);
+    b.record(10ms);
+
+    ssts::latency_histogram merged;
+    merged.merge(a);
+    merged.merge(b);
+
+    const auto s = merged.summary();
+    EXPECT_EQ(s.count, 251u);
+    EXPECT_LT(s.p50, 2ms);
+    EXPECT_GE(s.p99, 2ms);
+    EXPECT_EQ(s.max, 10ms);
+}
+
+class SchedulerStats : public ::testing::TestWithParam<ssts::dispatch_mode> { };
+
+TEST_P(SchedulerStats, LatenessIsRecorded)
+{
+    ssts::scheduler_options options;
+    options.pool.num_threads = 2;
+    options.pool.lateness_stats = true;
+    options.dispatch = GetParam();
+    ssts::task_scheduler s(options);
+    s.start();
+
+    s.every(5ms, []{ });
+    for (auto n = 0; n < 10; ++n)
+        s.in(std::chrono::milliseconds(n), []{ }).get();
+
+    std::this_thread::sleep_for(100ms);
+    s.stop();
+
+    const auto stats = s.stats();
+    EXPECT_GE(stats.scheduled_to_dispatch.count, 20u);
+    EXPECT_EQ(stats.dispatch_to_start.count, stats.scheduled_to_dispatch.count);
+    EXPECT_EQ(stats.scheduled_to_start.count, stats.scheduled_to_dispatch.count);
+
+    for (const auto& l : { stats.scheduled_to_dispatch, stats.dispatch_to_start, stats.scheduled_to_start })
+    {
+        EXPECT_LE(l.p50, l.p99);
+        EXPECT_LE(l.p99, l.p999);
+        EXPECT_LE(l.p999, l.max);
+        EXPECT_LT(l.p50, 1s);
+    }
+
+    EXPECT_GE(stats.scheduled_to_start.max, stats.scheduled_to_dispatch.p50);
+}
+
+INSTANTIATE_TEST_SUITE_P(Modes, SchedulerStats, ::testing::Values(ssts::dispatch_mode::scheduler_thread, ssts::dispatch_mode::leader_follower));
+
+TEST(SchedulerStatsDisabled, NothingIsRecorded)
+{
+    ssts::task_scheduler s(2);
+    s.start();
+    s.in(1ms, []{ }).get();
+    s.stop();
+
+    const auto stats = s.stats();
+    EXPECT_EQ(stats.scheduled_to_dispatch.count, 0u);
+    EXPECT_EQ(stats.dispatch_to_start.count, 0u);
+    EXPECT_EQ(stats.scheduled_to_start.count, 0u);
+}
+
+}
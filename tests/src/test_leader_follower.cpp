@@ -0,0 +1,132 @@
+#include "gtest/gtest.h"
+#include <ssts/task_scheduler.hpp>
+
+namespace ssts
+{
+
+class LeaderFollower : public ::testing::TestWithParam<ssts::pool_mode>
+{
+protected:
+    std::unique_ptr<ssts::task_scheduler> make_scheduler(unsigned int num_threads)
+    {
+        ssts::scheduler_options options;
+        options.pool.num_threads = num_threads;
+        options.pool.mode = GetParam();
+        options.dispatch = ssts::dispatch_mode::leader_follower;
+        return std::make_unique<ssts::task_scheduler>(options);
+    }
+};
+
+TEST_P(LeaderFollower, InAtEvery)
+{
+    auto s = make_scheduler(2);
+    s->start();
+
+    std::atomic_uint every_count = 0;
+    s->every("every_id"s, 10ms, [&every_count]{ ++every_count; });
+
+    const auto start = ssts::clock::now();
+    auto f_in = s->in(20ms, []{ return ssts::clock::now(); });
+    auto f_at = s->at(ssts::clock::now() + 30ms, []{ return 42; });
+
+    EXPECT_GE(f_in.get(), start + 20ms);
+    EXPECT_EQ(f_at.get(), 42);
+
+    std::this_thread::sleep_for(200ms);
+    EXPECT_TRUE(s->remove_task("every_id"));
+    s->stop();
+
+    EXPECT_GE(every_count, 10u);
+}
+
+TEST_P(LeaderFollower, SingleWorker)
+{
+    // The only worker is either the leader or runs due tasks: all of them run, none waits for the next time point.
+    auto s = make_scheduler(1);
+    s->start();
+
+    std::atomic_uint count = 0;
+    for (auto n = 0; n < 20; ++n)
+        s->post_in(10ms, [&count]{ ++count; });
+    s->post_in(1h, []{ });
+
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(count, 20u);
+    s->stop();
+}
+
+TEST_P(LeaderFollower, DueTaskRunsOnLeader)
+{
+    auto s = make_scheduler(1);
+    s->start();
+
+    // The leader task runs on the only worker, as any due task.
+    const auto worker_id = s->in(1ms, []{ return std::this_thread::get_id(); }).get();
+    EXPECT_NE(worker_id, std::this_thread::get_id());
+    EXPECT_EQ(s->in(1ms, []{ return std::this_thread::get_id(); }).get(), worker_id);
+    s->stop();
+}
+
+TEST_P(LeaderFollower, EarlierTaskWakesUpLeader)
+{
+    auto s = make_scheduler(2);
+    s->start();
+
+    s->post_in(1h, []{ });
+    std::this_thread::sleep_for(10ms);
+
+    const auto start = ssts::clock::now();
+    const auto run_time = s->in(10ms, []{ return ssts::clock::now(); }).get();
+    EXPECT_GE(run_time - start, 10ms);
+    EXPECT_LT(run_time - start, 500ms);
+    s->stop();
+}
+
+TEST_P(LeaderFollower, BlockingTasks)
+{
+    // Two workers blocked by long tasks: the next ones run once a worker is free.
+    auto s = make_scheduler(2);
+    s->start();
+
+    std::atomic_uint count = 0;
+    s->post_in(1ms, []{ std::this_thread::sleep_for(100ms); });
+    s->post_in(1ms, []{ std::this_thread::sleep_for(100ms); });
+    s->every(5ms, [&count]{ ++count; });
+
+    std::this_thread::sleep_for(300ms);
+    s->stop();
+    EXPECT_GE(count, 10u);
+}
+
+TEST_P(LeaderFollower, StopWhileIdle)
+{
+    auto s = make_scheduler(2);
+    s->start();
+    std::this_thread::sleep_for(10ms);
+
+    const auto start = ssts::clock::now();
+    s->stop();
+    EXPECT_LT(ssts::clock::now() - start, 500ms);
+}
+
+TEST_P(LeaderFollower, LatenessOfScheduledTasksOnly)
+{
+    std::atomic_uint reported_count = 0;
+    ssts::scheduler_options options;
+    options.pool.num_threads = 2;
+    options.pool.mode = GetParam();
+    options.pool.lateness_callback = [&reported_count](size_t, ssts::clock::duration){ ++reported_count; };
+    options.dispatch = ssts::dispatch_mode::leader_follower;
+    ssts::task_scheduler s(options);
+    s.start();
+
+    for (auto n = 0; n < 5; ++n)
+        s.in(std::chrono::milliseconds(10 * (n + 1)), []{ }).get();
+
+    s.stop();
+    EXPECT_EQ(reported_count, 5u);
+}
+
+INSTANTIATE_TEST_SUITE_P(Modes, LeaderFollower, ::testing::Values(ssts::pool_mode::shared_queue, ssts::pool_mode::work_stealing));
+
+}
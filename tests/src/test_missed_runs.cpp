@@ -0,0 +1,165 @@
+#include "gtest/gtest.h"
+#include <ssts/task_scheduler.hpp>
+
+namespace ssts
+{
+
+class MissedRuns : public ::testing::Test
+{
+protected:
+    // Schedule a recursive task whose first time point is in the past: the runs in between are missed.
+    void post_late(ssts::task_scheduler& s, ssts::clock::duration lateness, ssts::clock::duration interval)
+    {
+        std::vector<ssts::batch_task> tasks;
+        tasks.emplace_back(ssts::clock::now() - lateness, [this]{ record(); }, "task_id"s, interval);
+        s.post_batch(tasks.begin(), tasks.end());
+    }
+
+    void record()
+    {
+        std::scoped_lock lock(mtx);
+        runs.push_back(ssts::clock::now());
+    }
+
+    std::vector<ssts::clock::time_point> get_runs()
+    {
+        std::scoped_lock lock(mtx);
+        return runs;
+    }
+
+    std::mutex mtx;
+    std::vector<ssts::clock::time_point> runs;
+};
+
+TEST_F(MissedRuns, SkipKeepsTimeGrid)
+{
+    ssts::pool_options options;
+    options.num_threads = 2;
+    ssts::task_scheduler s(options);
+    s.start();
+
+    // Time points at -1050ms, -950ms, ..., -50ms are missed: the due one runs, the next slot is at +50ms.
+    post_late(s, 1050ms, 100ms);
+    std::this_thread::sleep_for(25ms);
+    EXPECT_EQ(get_runs().size(), 1u);
+    EXPECT_EQ(s.missed_runs("task_id"), 10u);
+
+    std::this_thread::sleep_for(60ms);
+    s.stop();
+
+    const auto r = get_runs();
+    ASSERT_EQ(r.size(), 2u);
+    EXPECT_LT(r[1] - r[0], 90ms);
+}
+
+TEST_F(MissedRuns, RunOnceRestartsInterval)
+{
+    ssts::scheduler_options options;
+    options.pool.num_threads = 2;
+    options.missed_runs = ssts::missed_run_policy::run_once;
+    ssts::task_scheduler s(options);
+    s.start();
+
+    post_late(s, 1050ms, 100ms);
+    std::this_thread::sleep_for(85ms);
+    EXPECT_EQ(get_runs().size(), 1u);
+    EXPECT_EQ(s.missed_runs("task_id"), 10u);
+
+    std::this_thread::sleep_for(50ms);
+    s.stop();
+
+    const auto r = get_runs();
+    ASSERT_EQ(r.size(), 2u);
+    EXPECT_GE(r[1] - r[0], 95ms);
+}
+
+TEST_F(MissedRuns, BurstIsCapped)
+{
+    ssts::pool_options options;
+    options.num_threads = 2;
+    ssts::task_scheduler s(options);
+
+    // The policy is set before the scheduler starts dispatching.
+    post_late(s, 1050ms, 100ms);
+    EXPECT_TRUE(s.set_missed_run_policy("task_id", ssts::missed_run_policy::burst, 3));
+    s.start();
+
+    std::this_thread::sleep_for(25ms);
+    EXPECT_EQ(s.missed_runs("task_id"), 10u);
+    s.stop();
+
+    EXPECT_EQ(get_runs().size(), 4u);
+}
+
+TEST_F(MissedRuns, BurstReplaysAllMissedRunsBelowCap)
+{
+    ssts::scheduler_options options;
+    options.pool.num_threads = 2;
+    options.missed_runs = ssts::missed_run_policy::burst;
+    options.max_burst = 10;
+    ssts::task_scheduler s(options);
+    s.start();
+
+    post_late(s, 250ms, 100ms);
+    std::this_thread::sleep_for(25ms);
+    EXPECT_EQ(s.missed_runs("task_id"), 2u);
+    s.stop();
+
+    EXPECT_EQ(get_runs().size(), 3u);
+}
+
+TEST_F(MissedRuns, BurstWithDuplicatesDisallowed)
+{
+    ssts::scheduler_options options;
+    options.pool.num_threads = 4;
+    options.missed_runs = ssts::missed_run_policy::burst;
+    ssts::task_scheduler s(options);
+    s.set_duplicate_allowed(false);
+    s.start();
+
+    // The replayed runs overlap with the due one: they must not be dropped as duplicates.
+    std::vector<ssts::batch_task> tasks;
+    tasks.emplace_back(ssts::clock::now() - 3500ms, [this]{ record(); std::this_thread::sleep_for(20ms); }, "task_id"s, 1s);
+    s.post_batch(tasks.begin(), tasks.end());
+
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(s.missed_runs("task_id"), 3u);
+    s.stop();
+
+    EXPECT_EQ(get_runs().size(), 4u);
+}
+
+TEST_F(MissedRuns, CatchUpIsConstantTime)
+{
+    ssts::pool_options options;
+    options.num_threads = 2;
+    ssts::task_scheduler s(options);
+    s.start();
+
+    // A day behind with a 1us interval: about 8.6e10 missed runs, that must not be stepped over one by one.
+    post_late(s, 24h, 1us);
+    std::this_thread::sleep_for(10ms);
+    const auto missed = s.missed_runs("task_id");
+    s.stop();
+
+    ASSERT_TRUE(missed.has_value());
+    EXPECT_GE(missed.value(), 86'400'000'000u);
+    EXPECT_FALSE(get_runs().empty());
+}
+
+TEST_F(MissedRuns, PolicyOfUnknownOrOneShotTask)
+{
+    ssts::pool_options options;
+    options.num_threads = 2;
+    ssts::task_scheduler s(options);
+    s.start();
+    s.in("one_shot"s, 1h, []{ });
+
+    EXPECT_FALSE(s.set_missed_run_policy("unknown", ssts::missed_run_policy::skip));
+    EXPECT_FALSE(s.set_missed_run_policy("one_shot", ssts::missed_run_policy::burst));
+    EXPECT_EQ(s.missed_runs("unknown"), std::nullopt);
+    EXPECT_EQ(s.missed_runs("one_shot"), 0u);
+    s.stop();
+}
+
+}
@@ -26,4 +26,77 @@ TEST(Pool, MoreTasksThenThreadSize)
     tp->stop();
 }
 
+TEST(Pool, DuplicatePoppedWhileRunningIsDropped)
+{
+    std::atomic_uint count = 0;
+    ssts::pool_options options;
+    options.num_threads = 2;
+    ssts::task_pool tp(options);
+    tp.set_duplicate_allowed(false);
+
+    // Keep both workers busy, so that both tasks with the same hash are queued before any of them runs.
+    std::promise<void> release;
+    auto f = release.get_future().share();
+    tp.post([f]{ f.wait(); });
+    tp.post([f]{ f.wait(); });
+    std::this_thread::sleep_for(20ms);
+
+    tp.post([&count]{ ++count; std::this_thread::sleep_for(50ms); }, 1);
+    tp.post([&count]{ ++count; }, 1);
+    release.set_value();
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(count, 1u);
+
+    // The hash is released when the task that runs completes.
+    tp.submit([&count]{ ++count; }, 1).get();
+    EXPECT_EQ(count, 2u);
+    tp.stop();
+}
+
+TEST(Pool, TasksWithoutIdAreNotTracked)
+{
+    std::atomic_uint count = 0;
+    ssts::pool_options options;
+    options.num_threads = 2;
+    ssts::task_pool tp(options);
+    tp.set_duplicate_allowed(false);
+
+    std::promise<void> release;
+    tp.post([f = release.get_future().share()]{ f.wait(); }, 0);
+    std::this_thread::sleep_for(20ms);
+
+    // A task without a task id neither collides with, nor releases, the hash of the running task.
+    EXPECT_EQ(tp.submit([]{ return 1; }).get(), 1);
+    tp.post([&count]{ ++count; }, 0);
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(count, 0u);
+
+    release.set_value();
+    tp.stop();
+}
+
+TEST(Pool, DuplicateFlagChangedWhileRunning)
+{
+    std::atomic_uint count = 0;
+    ssts::pool_options options;
+    options.num_threads = 2;
+    ssts::task_pool tp(options);
+    tp.set_duplicate_allowed(false);
+
+    std::promise<void> release;
+    tp.post([f = release.get_future().share()]{ f.wait(); }, 1);
+    std::this_thread::sleep_for(20ms);
+
+    // The running task still releases its hash once duplicates are allowed again.
+    tp.set_duplicate_allowed(true);
+    release.set_value();
+    std::this_thread::sleep_for(20ms);
+
+    tp.set_duplicate_allowed(false);
+    tp.post([&count]{ ++count; }, 1);
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(count, 1u);
+    tp.stop();
+}
+
 }
@@ -0,0 +1,155 @@
+#include "gtest/gtest.h"
+#include <ssts/task_scheduler.hpp>
+
+namespace ssts
+{
+
+class PoolStats : public ::testing::TestWithParam<ssts::pool_mode>
+{
+protected:
+    ssts::pool_options make_options(unsigned int num_threads) const
+    {
+        ssts::pool_options options;
+        options.num_threads = num_threads;
+        options.mode = GetParam();
+        options.utilization_stats = true;
+        return options;
+    }
+};
+
+TEST_P(PoolStats, BusyAndIdleTime)
+{
+    ssts::task_pool tp(make_options(2));
+
+    for (auto n = 0; n < 4; ++n)
+        tp.post([]{ std::this_thread::sleep_for(20ms); });
+
+    tp.submit([]{ }).get();
+    std::this_thread::sleep_for(100ms);
+    const auto s = tp.stats();
+    tp.stop();
+
+    ASSERT_EQ(s.workers.size(), 2u);
+    EXPECT_EQ(s.tasks_executed, 5u);
+    EXPECT_GE(s.busy_time, 80ms);
+    EXPECT_GE(s.idle_time, 100ms);
+    EXPECT_GT(s.utilization(), 0.0);
+    EXPECT_LT(s.utilization(), 1.0);
+    EXPECT_EQ(s.queue_depth, 0u);
+
+    uint64_t tasks = 0;
+    for (const auto& w : s.workers)
+    {
+        EXPECT_TRUE(w.is_running);
+        EXPECT_GE(w.parks, w.wakeups);
+        tasks += w.tasks_executed;
+    }
+    EXPECT_EQ(tasks, s.tasks_executed);
+}
+
+TEST_P(PoolStats, QueueDepthAndWait)
+{
+    ssts::task_pool tp(make_options(1));
+
+    // Keep the only worker busy while tasks are queued.
+    std::promise<void> release;
+    tp.post([f = release.get_future().share()]{ f.wait(); });
+    std::this_thread::sleep_for(20ms);
+
+    for (auto n = 0; n < 10; ++n)
+        tp.post([]{ });
+
+    std::this_thread::sleep_for(30ms);
+    EXPECT_EQ(tp.stats().queue_depth, 10u);
+
+    release.set_value();
+    tp.submit([]{ }).get();
+    tp.stop();
+
+    const auto s = tp.stats();
+    EXPECT_EQ(s.tasks_executed, 12u);
+    EXPECT_GE(s.max_queue_depth, 9u);
+    EXPECT_GT(s.mean_queue_depth, 0.0);
+    EXPECT_GE(s.max_queue_wait, 30ms);
+    EXPECT_LE(s.mean_queue_wait, s.max_queue_wait);
+    EXPECT_FALSE(s.workers.front().is_running);
+}
+
+TEST_P(PoolStats, ParksAndWakeups)
+{
+    ssts::task_pool tp(make_options(1));
+
+    for (auto n = 0; n < 3; ++n)
+    {
+        std::this_thread::sleep_for(20ms);
+        tp.submit([]{ }).get();
+    }
+
+    tp.stop();
+    const auto s = tp.stats();
+    EXPECT_GE(s.workers.front().parks, 3u);
+    EXPECT_GE(s.workers.front().wakeups, 3u);
+}
+
+TEST_P(PoolStats, PeriodicCallback)
+{
+    std::mutex mtx;
+    std::vector<ssts::pool_stats> snapshots;
+
+    auto options = make_options(2);
+    options.utilization_stats = false;
+    options.stats_interval = 20ms;
+    options.stats_callback = [&mtx, &snapshots](const ssts::pool_stats& s)
+    {
+        std::scoped_lock lock(mtx);
+        snapshots.push_back(s);
+    };
+
+    ssts::task_pool tp(options);
+    tp.submit([]{ }).get();
+    std::this_thread::sleep_for(110ms);
+    tp.stop();
+
+    const auto count = snapshots.size();
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(snapshots.size(), count);
+
+    ASSERT_GE(count, 3u);
+    EXPECT_EQ(snapshots.back().tasks_executed, 1u);
+    EXPECT_GT(snapshots.back().idle_time, snapshots.front().idle_time);
+}
+
+INSTANTIATE_TEST_SUITE_P(Modes, PoolStats, ::testing::Values(ssts::pool_mode::shared_queue, ssts::pool_mode::work_stealing));
+
+TEST(PoolStatsDisabled, OnlyQueueDepth)
+{
+    ssts::task_pool tp(2);
+    tp.submit([]{ }).get();
+    const auto s = tp.stats();
+    tp.stop();
+
+    EXPECT_TRUE(s.workers.empty());
+    EXPECT_EQ(s.tasks_executed, 0u);
+    EXPECT_EQ(s.queue_depth, 0u);
+}
+
+TEST(PoolStatsScheduler, LeaderTimeIsBusy)
+{
+    ssts::scheduler_options options;
+    options.pool.num_threads = 2;
+    options.pool.utilization_stats = true;
+    options.dispatch = ssts::dispatch_mode::leader_follower;
+    ssts::task_scheduler s(options);
+    s.start();
+
+    s.every(10ms, []{ });
+    std::this_thread::sleep_for(100ms);
+    const auto stats = s.pool_stats();
+    s.stop();
+
+    // One of the two workers is always the timer leader.
+    EXPECT_GE(stats.tasks_executed, 10u);
+    EXPECT_GT(stats.utilization(), 0.3);
+}
+
+}
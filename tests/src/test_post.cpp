@@ -0,0 +1,61 @@
+#include "scheduler_fixture.hpp"
+
+namespace ssts
+{
+
+class Post : public SchedulerTest { };
+
+TEST(PoolPost, FunctionOnly)
+{
+    std::atomic_uint count = 0;
+    {
+        ssts::task_pool tp(2);
+        for (auto n = 0; n < 16; ++n)
+            tp.post([&count]{ ++count; });
+
+        std::this_thread::sleep_for(500ms);
+        tp.stop();
+    }
+    EXPECT_EQ(count, 16u);
+}
+
+TEST_F(Post, PostAt)
+{
+    std::atomic_uint count = 0;
+    InitScheduler(2u);
+    s->post_at(ssts::clock::now() + 100ms, [&count]{ ++count; });
+    s->post_at(ssts::clock::now() + 100ms, [&count](auto p){ count += p; }, 2u);
+
+    EXPECT_EQ(get_size(), 2u);
+    Sleep(200ms);
+
+    EXPECT_EQ(get_size(), 0u);
+    EXPECT_EQ(count, 3u);
+}
+
+TEST_F(Post, PostInTaskId)
+{
+    std::atomic_uint count = 0;
+    InitScheduler(2u);
+    s->post_in("task_id"s, 100ms, [&count]{ ++count; });
+
+    EXPECT_TRUE(s->is_scheduled("task_id"));
+    Sleep(200ms);
+
+    EXPECT_FALSE(s->is_scheduled("task_id"));
+    EXPECT_EQ(count, 1u);
+}
+
+TEST_F(Post, RemoveBeforeRun)
+{
+    std::atomic_uint count = 0;
+    InitScheduler(2u);
+    s->post_in("task_id"s, 100ms, [&count]{ ++count; });
+
+    EXPECT_TRUE(s->remove_task("task_id"));
+    Sleep(200ms);
+
+    EXPECT_EQ(count, 0u);
+}
+
+}
@@ -0,0 +1,144 @@
+#include "gtest/gtest.h"
+#include <ssts/task_scheduler.hpp>
+
+namespace ssts
+{
+
+class Priority : public ::testing::TestWithParam<ssts::pool_mode>
+{
+protected:
+    void record(char c)
+    {
+        std::scoped_lock lock(mtx);
+        order.push_back(c);
+    }
+
+    std::string get_order()
+    {
+        std::scoped_lock lock(mtx);
+        return order;
+    }
+
+    std::mutex mtx;
+    std::string order;
+};
+
+TEST_P(Priority, HigherPriorityFirst)
+{
+    ssts::pool_options options;
+    options.num_threads = 1;
+    options.mode = GetParam();
+    ssts::task_pool tp(options);
+
+    // Keep the only worker busy while tasks are queued.
+    std::promise<void> release;
+    tp.post([f = release.get_future().share()]{ f.wait(); });
+    std::this_thread::sleep_for(50ms);
+
+    for (auto n = 0; n < 3; ++n)
+    {
+        tp.post(ssts::priority::low, [this]{ record('l'); });
+        tp.post([this]{ record('n'); });
+        tp.post(ssts::priority::high, [this]{ record('h'); });
+    }
+
+    release.set_value();
+    tp.submit(ssts::priority::low, []{ }).get();
+    tp.stop();
+
+    EXPECT_EQ(get_order(), "hhhnnnlll");
+}
+
+TEST_P(Priority, StarvationProtection)
+{
+    ssts::pool_options options;
+    options.num_threads = 1;
+    options.mode = GetParam();
+    options.starvation_timeout = 50ms;
+    ssts::task_pool tp(options);
+
+    std::promise<void> release;
+    tp.post([f = release.get_future().share()]{ f.wait(); });
+    std::this_thread::sleep_for(50ms);
+
+    tp.post(ssts::priority::low, [this]{ record('l'); });
+    std::this_thread::sleep_for(20ms);
+    for (auto n = 0; n < 5; ++n)
+        tp.post(ssts::priority::high, [this]{ record('h'); });
+
+    // The low priority task has been queued longer than starvation_timeout, and before any high priority task.
+    std::this_thread::sleep_for(100ms);
+    release.set_value();
+    tp.submit(ssts::priority::low, []{ }).get();
+    tp.stop();
+
+    EXPECT_EQ(get_order(), "lhhhhh");
+}
+
+TEST_P(Priority, RunWithPriority)
+{
+    ssts::pool_options options;
+    options.num_threads = 2;
+    options.mode = GetParam();
+    ssts::task_pool tp(options);
+    EXPECT_EQ(tp.run(ssts::priority::high, []{ return 1; }).get(), 1);
+    EXPECT_EQ(tp.submit(ssts::priority::low, []{ return 2; }).get(), 2);
+    tp.stop();
+}
+
+INSTANTIATE_TEST_SUITE_P(Modes, Priority, ::testing::Values(ssts::pool_mode::shared_queue, ssts::pool_mode::work_stealing));
+
+TEST(PriorityWorkStealing, HighPriorityBeforeLocalTasks)
+{
+    std::mutex mtx;
+    std::string order;
+    auto record = [&mtx, &order](char c) { std::scoped_lock lock(mtx); order.push_back(c); };
+
+    ssts::pool_options options;
+    options.num_threads = 1;
+    options.mode = ssts::pool_mode::work_stealing;
+    ssts::task_pool tp(options);
+    tp.submit([&tp, &record]
+    {
+        // Normal priority tasks pushed by a worker go to its local deque, high priority ones to the shared queue.
+        for (auto n = 0; n < 3; ++n)
+            tp.post([&record]{ record('n'); });
+
+        tp.post(ssts::priority::high, [&record]{ record('h'); });
+    }).get();
+
+    std::this_thread::sleep_for(100ms);
+    tp.stop();
+
+    EXPECT_EQ(order, "hnnn");
+}
+
+TEST(PriorityScheduler, HeartbeatNotDelayedByBulkTasks)
+{
+    std::mutex mtx;
+    std::string order;
+    auto record = [&mtx, &order](char c) { std::scoped_lock lock(mtx); order.push_back(c); };
+
+    ssts::pool_options options;
+    options.num_threads = 1;
+    options.starvation_timeout = 1s;
+    ssts::task_scheduler s(options);
+    s.start();
+
+    // A bulk task keeps the only worker busy from 10ms to 110ms, while more bulk tasks (at 20ms),
+    // a high priority task (at 30ms) and heartbeats (at 40ms and 80ms) become due.
+    s.in(10ms, []{ std::this_thread::sleep_for(100ms); });
+    for (auto n = 0; n < 5; ++n)
+        s.in(20ms, [&record]{ record('b'); });
+    s.in(ssts::priority::high, 30ms, [&record]{ record('h'); });
+    s.every(ssts::priority::high, "heartbeat"s, 40ms, [&record]{ record('h'); });
+
+    std::this_thread::sleep_for(300ms);
+    s.stop();
+
+    // The first heartbeat runs at once, all the high priority tasks queued behind the blocking task run before the bulk ones.
+    ASSERT_GE(order.size(), 9u);
+    EXPECT_EQ(order.substr(0, 5), "hhhhb");
+}
+
+}
@@ -0,0 +1,240 @@
+#include "gtest/gtest.h"
+#include <ssts/task_scheduler.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace ssts
+{
+
+template<typename QueueType>
+class Queue : public ::testing::Test
+{
+protected:
+    Queue() : base{ ssts::clock::now() } { }
+
+    std::vector<int> collect(const ssts::clock::time_point& now)
+    {
+        std::vector<typename QueueType::handle> due;
+        queue.collect_due(now, due);
+
+        std::vector<int> values;
+        for (auto h : due)
+        {
+            EXPECT_LE(queue.time_point(h), now);
+            values.push_back(queue.value(h));
+            queue.erase(h);
+        }
+
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+
+    QueueType queue;
+    const ssts::clock::time_point base;
+};
+
+using QueueTypes = ::testing::Types<
+    ssts::multimap_queue<int>,
+    ssts::dary_heap_queue<int>,
+    ssts::dary_heap_queue<int, 2>,
+    ssts::timing_wheel_queue<int>,
+    ssts::timing_wheel_queue<int, std::chrono::microseconds>>;
+
+TYPED_TEST_SUITE(Queue, QueueTypes);
+
+TYPED_TEST(Queue, CollectDueInOrder)
+{
+    this->queue.insert(this->base + 30ms, 30);
+    this->queue.insert(this->base + 10ms, 10);
+    this->queue.insert(this->base + 20ms, 20);
+    EXPECT_EQ(this->queue.size(), 3u);
+    // Timing wheels round time points up to the next tick boundary (at most 1ms here).
+    EXPECT_LE(this->queue.next_time_point(), this->base + 11ms);
+
+    EXPECT_EQ(this->collect(this->base + 5ms), std::vector<int>{});
+    EXPECT_EQ(this->collect(this->base + 15ms), std::vector<int>{ 10 });
+    EXPECT_EQ(this->collect(this->base + 1h), (std::vector<int>{ 20, 30 }));
+    EXPECT_TRUE(this->queue.empty());
+}
+
+TYPED_TEST(Queue, PastTimePointIsDue)
+{
+    this->queue.insert(this->base - 1s, 1);
+    EXPECT_LE(this->queue.next_time_point(), ssts::clock::now());
+    EXPECT_EQ(this->collect(this->base), std::vector<int>{ 1 });
+}
+
+TYPED_TEST(Queue, Erase)
+{
+    auto h = this->queue.insert(this->base + 10ms, 10);
+    this->queue.insert(this->base + 20ms, 20);
+    this->queue.erase(h);
+
+    EXPECT_EQ(this->queue.size(), 1u);
+    EXPECT_EQ(this->collect(this->base + 1s), std::vector<int>{ 20 });
+}
+
+TYPED_TEST(Queue, Reschedule)
+{
+    auto h = this->queue.insert(this->base + 10ms, 10);
+    h = this->queue.reschedule(h, this->base + 2min);
+
+    EXPECT_EQ(this->queue.time_point(h), this->base + 2min);
+    EXPECT_EQ(this->collect(this->base + 1min), std::vector<int>{});
+    EXPECT_EQ(this->collect(this->base + 3min), std::vector<int>{ 10 });
+}
+
+TYPED_TEST(Queue, RescheduleCollected)
+{
+    this->queue.insert(this->base + 10ms, 10);
+
+    std::vector<typename TypeParam::handle> due;
+    this->queue.collect_due(this->base + 20ms, due);
+    ASSERT_EQ(due.size(), 1u);
+    this->queue.reschedule(due.front(), this->base + 30ms);
+
+    EXPECT_EQ(this->queue.size(), 1u);
+    EXPECT_EQ(this->collect(this->base + 25ms), std::vector<int>{});
+    EXPECT_EQ(this->collect(this->base + 35ms), std::vector<int>{ 10 });
+}
+
+TYPED_TEST(Queue, ForEachBefore)
+{
+    for (int n = 1; n <= 100; ++n)
+        this->queue.insert(this->base + n * 10ms, int{ n });
+
+    std::vector<int> visited;
+    this->queue.for_each_before(this->base + 255ms, [this, &visited](auto h)
+    {
+        visited.push_back(this->queue.value(h));
+        return this->base + 255ms;
+    });
+    std::sort(visited.begin(), visited.end());
+    EXPECT_EQ(visited.size(), 25u);
+    EXPECT_EQ(visited.back(), 25);
+
+    // Lowering the limit while visiting: the minimum of time point + 35ms over all the values.
+    auto earliest = ssts::clock::time_point::max();
+    this->queue.for_each_before(earliest, [this, &earliest](auto h)
+    {
+        earliest = std::min(earliest, this->queue.time_point(h) + 35ms);
+        return earliest;
+    });
+    EXPECT_EQ(earliest, this->base + 45ms);
+}
+
+TYPED_TEST(Queue, Clear)
+{
+    for (int n = 0; n < 1000; ++n)
+        this->queue.insert(this->base + n * 1ms, int{ n });
+
+    this->queue.clear();
+    EXPECT_TRUE(this->queue.empty());
+    EXPECT_EQ(this->collect(this->base + 1h), std::vector<int>{});
+}
+
+TYPED_TEST(Queue, RandomTimePoints)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int64_t> delay_us(0, std::chrono::microseconds(10min).count());
+
+    std::vector<ssts::clock::time_point> time_points;
+    for (int n = 0; n < 10'000; ++n)
+    {
+        time_points.push_back(this->base + std::chrono::microseconds(delay_us(rng)));
+        this->queue.insert(time_points.back(), int{ n });
+    }
+
+    // Advance time with irregular steps, checking that values are never collected early
+    // and that no value is left behind once its time point is one second in the past.
+    std::uniform_int_distribution<int64_t> step_ms(1, 20'000);
+    std::vector<bool> is_collected(time_points.size(), false);
+    auto now = this->base;
+    while (!this->queue.empty())
+    {
+        now += std::chrono::milliseconds(step_ms(rng));
+        for (auto n : this->collect(now))
+        {
+            EXPECT_FALSE(is_collected[n]);
+            is_collected[n] = true;
+        }
+
+        for (size_t n = 0; n < time_points.size(); ++n)
+        {
+            if (time_points[n] + 1s <= now)
+            {
+                EXPECT_TRUE(is_collected[n]);
+            }
+        }
+    }
+
+    EXPECT_TRUE(std::all_of(is_collected.begin(), is_collected.end(), [](bool b) { return b; }));
+}
+
+TYPED_TEST(Queue, RescheduleKeepsHandle)
+{
+    std::vector<typename TypeParam::handle> handles;
+    for (int n = 0; n < 100; ++n)
+        handles.push_back(this->queue.insert(this->base + 1h + n * 1ms, int{ n }));
+
+    // Move every other value before all the others, in reverse order.
+    for (int n = 0; n < 100; n += 2)
+        handles[n] = this->queue.reschedule(handles[n], this->base + (100 - n) * 1ms);
+
+    for (int n = 0; n < 100; ++n)
+        EXPECT_EQ(this->queue.value(handles[n]), n);
+
+    auto even = this->collect(this->base + 200ms);
+    ASSERT_EQ(even.size(), 50u);
+    for (size_t n = 0; n < even.size(); ++n)
+        EXPECT_EQ(even[n], static_cast<int>(2 * n));
+
+    EXPECT_EQ(this->queue.size(), 50u);
+}
+
+TYPED_TEST(Queue, InsertWithHint)
+{
+    // Hints are only an optimization: a wrong hint must not break the ordering.
+    auto h = this->queue.insert(this->base + 10ms, 10);
+    h = this->queue.insert(h, this->base + 20ms, 20);
+    h = this->queue.insert(h, this->base + 30ms, 30);
+    this->queue.insert(h, this->base + 5ms, 5);
+
+    EXPECT_EQ(this->collect(this->base + 15ms), (std::vector<int>{ 5, 10 }));
+    EXPECT_EQ(this->collect(this->base + 1h), (std::vector<int>{ 20, 30 }));
+}
+
+template<typename QueuePolicy>
+class SchedulerQueuePolicy : public ::testing::Test { };
+
+using QueuePolicies = ::testing::Types<
+    ssts::multimap_queue_policy,
+    ssts::dary_heap_queue_policy<>,
+    ssts::timing_wheel_queue_policy<>>;
+
+TYPED_TEST_SUITE(SchedulerQueuePolicy, QueuePolicies);
+
+TYPED_TEST(SchedulerQueuePolicy, InEveryRemove)
+{
+    ssts::basic_task_scheduler<TypeParam> s(2);
+    s.start();
+
+    std::atomic_uint in_count = 0;
+    std::atomic_uint every_count = 0;
+    s.in(50ms, [&in_count]{ ++in_count; });
+    s.every("every_id"s, 50ms, [&every_count]{ ++every_count; });
+    s.in("removed_id"s, 50ms, [&in_count]{ ++in_count; });
+    EXPECT_TRUE(s.remove_task("removed_id"));
+
+    std::this_thread::sleep_for(500ms);
+    EXPECT_TRUE(s.is_scheduled("every_id"));
+    EXPECT_TRUE(s.update_interval("every_id", 10ms));
+    std::this_thread::sleep_for(200ms);
+    s.stop();
+
+    EXPECT_EQ(in_count, 1u);
+    EXPECT_GE(every_count, 10u);
+}
+
+}
@@ -0,0 +1,124 @@
+#include "scheduler_fixture.hpp"
+#include <ssts/mpsc_queue.hpp>
+#include <thread>
+#include <vector>
+
+namespace ssts
+{
+
+class Submission : public SchedulerTest { };
+
+TEST(MpscQueue, Fifo)
+{
+    ssts::mpsc_queue<int> q;
+    EXPECT_TRUE(q.empty());
+
+    for (int n = 0; n < 10; ++n)
+        q.push(int{ n });
+
+    EXPECT_FALSE(q.empty());
+    for (int n = 0; n < 10; ++n)
+        EXPECT_EQ(q.pop(), n);
+
+    EXPECT_TRUE(q.empty());
+    EXPECT_FALSE(q.pop().has_value());
+}
+
+TEST(MpscQueue, MultipleProducers)
+{
+    constexpr int n_producers = 4;
+    constexpr int n_values = 10'000;
+    ssts::mpsc_queue<std::pair<int, int>> q;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < n_producers; ++p)
+        producers.emplace_back([&q, p] { for (int n = 0; n < n_values; ++n) q.push({ p, n }); });
+
+    // Values from the same producer must be popped in push order.
+    std::vector<int> next(n_producers, 0);
+    int popped = 0;
+    while (popped < n_producers * n_values)
+    {
+        if (auto v = q.pop())
+        {
+            EXPECT_EQ(v->second, next[v->first]++);
+            ++popped;
+        }
+    }
+
+    for (auto& t : producers)
+        t.join();
+
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(MpscQueue, EmptyWhilePopping)
+{
+    constexpr int n_values = 10'000;
+    ssts::mpsc_queue<int> q;
+    std::atomic_bool is_done = false;
+
+    // empty() is called by a thread that is neither the consumer nor a producer, as the spinning scheduler does.
+    std::thread observer([&q, &is_done] { while (!is_done) { (void)q.empty(); } });
+
+    for (int n = 0; n < n_values; ++n)
+    {
+        q.push(int{ n });
+        EXPECT_EQ(q.pop(), n);
+    }
+
+    is_done = true;
+    observer.join();
+    EXPECT_TRUE(q.empty());
+}
+
+TEST_F(Submission, ConcurrentProducers)
+{
+    constexpr unsigned n_producers = 4;
+    constexpr unsigned n_tasks_per_producer = 1'000;
+    std::atomic_uint count = 0;
+    InitScheduler(2u);
+
+    std::vector<std::thread> producers;
+    for (unsigned p = 0; p < n_producers; ++p)
+        producers.emplace_back([this, &count] 
+        { 
+            for (unsigned n = 0; n < n_tasks_per_producer; ++n) 
+                s->post_in(10ms, [&count]{ ++count; }); 
+        });
+
+    for (auto& t : producers)
+        t.join();
+
+    Sleep(200ms);
+    EXPECT_EQ(count, n_producers * n_tasks_per_producer);
+    EXPECT_EQ(get_size(), 0u);
+}
+
+TEST_F(Submission, EarlierTaskWakesScheduler)
+{
+    std::atomic_uint count = 0;
+    InitScheduler(2u);
+    s->post_in(1h, []{ });
+    Sleep(50ms);
+
+    s->post_in(50ms, [&count]{ ++count; });
+    Sleep(100ms);
+
+    EXPECT_EQ(count, 1u);
+    EXPECT_EQ(get_size(), 1u);
+}
+
+TEST_F(Submission, VisibleToLookupsImmediately)
+{
+    InitScheduler(2u);
+    s->post_in("task_id"s, 1h, []{ });
+
+    EXPECT_TRUE(s->is_scheduled("task_id"));
+    EXPECT_TRUE(s->set_enabled("task_id", false));
+    EXPECT_FALSE(s->is_enabled("task_id"));
+    EXPECT_TRUE(s->remove_task("task_id"));
+    EXPECT_EQ(get_size(), 0u);
+}
+
+}
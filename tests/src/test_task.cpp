@@ -0,0 +1,90 @@
+#include "gtest/gtest.h"
+#include <ssts/task.hpp>
+#include <array>
+#include <memory>
+
+namespace ssts
+{
+
+struct instance_counter
+{
+    explicit instance_counter(int& count) : _count{count} { ++_count; }
+    instance_counter(const instance_counter& other) : _count{other._count} { ++_count; }
+    instance_counter(instance_counter&& other) noexcept : _count{other._count} { ++_count; }
+    ~instance_counter() { --_count; }
+    int& _count;
+};
+
+TEST(Task, SmallCallableIsStoredInline)
+{
+    int value = 0;
+    auto small = [&value]{ ++value; };
+    auto large = [&value, data = std::array<char, 256>{}]{ value += data[0] + 1; };
+
+    EXPECT_TRUE(ssts::task::is_stored_inline<decltype(small)>());
+    EXPECT_FALSE(ssts::task::is_stored_inline<decltype(large)>());
+    EXPECT_TRUE(ssts::basic_task<512>::is_stored_inline<decltype(large)>());
+
+    ssts::task t1(std::move(small));
+    ssts::task t2(std::move(large));
+    t1();
+    t2.invoke();
+    EXPECT_EQ(value, 2);
+}
+
+TEST(Task, MoveOnlyCallable)
+{
+    auto p = std::make_unique<int>(41);
+    ssts::task t([p = std::move(p)]{ ++(*p); EXPECT_EQ(*p, 42); });
+    ssts::task moved(std::move(t));
+    moved();
+}
+
+TEST(Task, InlineCallableDestroyedOnce)
+{
+    int count = 0;
+    {
+        ssts::task t([c = instance_counter(count)]{ });
+        ssts::task moved(std::move(t));
+        ssts::task moved_again(std::move(moved));
+        EXPECT_EQ(count, 1);
+    }
+    EXPECT_EQ(count, 0);
+}
+
+TEST(Task, HeapCallableDestroyedOnce)
+{
+    int count = 0;
+    {
+        ssts::task t([c = instance_counter(count), data = std::array<char, 256>{}]{ });
+        ssts::task moved(std::move(t));
+        EXPECT_EQ(count, 1);
+    }
+    EXPECT_EQ(count, 0);
+}
+
+TEST(Task, MoveAssignment)
+{
+    int count = 0;
+    int value = 0;
+    {
+        ssts::task inline_task([c = instance_counter(count), &value]{ value += 1; });
+        ssts::task heap_task([c = instance_counter(count), &value, data = std::array<char, 256>{}]{ value += 10 + data[0]; });
+        EXPECT_EQ(count, 2);
+
+        // The callable object of the assigned task is destroyed.
+        inline_task = std::move(heap_task);
+        EXPECT_EQ(count, 1);
+        inline_task();
+        EXPECT_EQ(value, 10);
+
+        ssts::task other([c = instance_counter(count), &value]{ value += 100; });
+        inline_task = std::move(other);
+        EXPECT_EQ(count, 1);
+        inline_task();
+        EXPECT_EQ(value, 110);
+    }
+    EXPECT_EQ(count, 0);
+}
+
+}
@@ -0,0 +1,175 @@
+#include "gtest/gtest.h"
+#include <ssts/task_scheduler.hpp>
+
+namespace ssts
+{
+
+class TaskMetrics : public ::testing::TestWithParam<ssts::dispatch_mode>
+{
+protected:
+    ssts::scheduler_options make_options() const
+    {
+        ssts::scheduler_options options;
+        options.pool.num_threads = 2;
+        options.per_task_metrics = true;
+        options.dispatch = GetParam();
+        return options;
+    }
+};
+
+TEST_P(TaskMetrics, RecursiveTask)
+{
+    ssts::task_scheduler s(make_options());
+    s.start();
+
+    const auto start = ssts::clock::now();
+    s.every("task_id"s, 20ms, []{ std::this_thread::sleep_for(5ms); });
+    std::this_thread::sleep_for(110ms);
+    s.set_enabled("task_id", false);
+
+    // Wait for the last run to complete: the disabled task is still scheduled, so its metrics can be queried.
+    std::this_thread::sleep_for(20ms);
+    const auto m = s.metrics("task_id");
+    s.stop();
+
+    ASSERT_TRUE(m.has_value());
+    EXPECT_GE(m->runs, 4u);
+    EXPECT_LE(m->runs, 7u);
+    EXPECT_GE(m->total_time, m->runs * 5ms);
+    EXPECT_GE(m->max_time, 5ms);
+    EXPECT_LE(m->max_time, m->total_time);
+    EXPECT_GE(m->last_start, start);
+    EXPECT_GE(m->last_end, m->last_start + 5ms);
+    EXPECT_EQ(m->overruns, 0u);
+
+    // Sleeping does not consume CPU time.
+    EXPECT_LT(m->cpu_time, m->total_time);
+}
+
+TEST_P(TaskMetrics, Overruns)
+{
+    ssts::task_scheduler s(make_options());
+    s.set_duplicate_allowed(false);
+    s.start();
+
+    s.every("slow"s, 10ms, []{ std::this_thread::sleep_for(25ms); });
+    std::this_thread::sleep_for(100ms);
+    s.set_enabled("slow", false);
+    std::this_thread::sleep_for(30ms);
+
+    const auto m = s.metrics("slow");
+    s.stop();
+
+    ASSERT_TRUE(m.has_value());
+    EXPECT_GE(m->runs, 2u);
+    EXPECT_EQ(m->overruns, m->runs);
+}
+
+TEST_P(TaskMetrics, DuplicatesAccumulate)
+{
+    ssts::task_scheduler s(make_options());
+    s.start();
+
+    s.every("dup"s, 10ms, []{ });
+    s.every("dup"s, 10ms, []{ });
+    s.every(10ms, []{ });
+    std::this_thread::sleep_for(55ms);
+
+    // Both duplicates accumulate into the same metrics.
+    const auto m = s.metrics("dup");
+    ASSERT_TRUE(m.has_value());
+    EXPECT_GE(m->runs, 6u);
+    EXPECT_FALSE(s.metrics("unknown").has_value());
+    s.stop();
+}
+
+TEST_P(TaskMetrics, OneShotTask)
+{
+    ssts::task_scheduler s(make_options());
+    s.start();
+
+    s.in("one_shot"s, 1ms, []{ }).get();
+
+    // The future is ready before the metrics of the run are updated.
+    std::this_thread::sleep_for(20ms);
+    EXPECT_FALSE(s.is_scheduled("one_shot"));
+
+    const auto m = s.metrics("one_shot");
+    ASSERT_TRUE(m.has_value());
+    EXPECT_EQ(m->runs, 1u);
+    EXPECT_EQ(m->overruns, 0u);
+    s.stop();
+}
+
+TEST_P(TaskMetrics, DroppedOnRemove)
+{
+    ssts::task_scheduler s(make_options());
+    s.start();
+
+    s.every("task_id"s, 10ms, []{ });
+    std::this_thread::sleep_for(30ms);
+    EXPECT_TRUE(s.metrics("task_id").has_value());
+
+    s.remove_task("task_id");
+    EXPECT_FALSE(s.metrics("task_id").has_value());
+
+    // A task scheduled again after the last one has been removed starts from new metrics.
+    s.every("task_id"s, 1s, []{ });
+    const auto m = s.metrics("task_id");
+    ASSERT_TRUE(m.has_value());
+    EXPECT_EQ(m->runs, 0u);
+    s.stop();
+}
+
+TEST_P(TaskMetrics, RetiredAreBounded)
+{
+    auto options = make_options();
+    options.max_retired_metrics = 2;
+    ssts::task_scheduler s(options);
+    s.start();
+
+    s.in("first"s, 1ms, []{ }).get();
+    s.in("second"s, 1ms, []{ }).get();
+    s.in("third"s, 1ms, []{ }).get();
+    std::this_thread::sleep_for(20ms);
+
+    EXPECT_FALSE(s.metrics("first").has_value());
+    EXPECT_TRUE(s.metrics("second").has_value());
+    EXPECT_TRUE(s.metrics("third").has_value());
+    s.stop();
+}
+
+INSTANTIATE_TEST_SUITE_P(Modes, TaskMetrics, ::testing::Values(ssts::dispatch_mode::scheduler_thread, ssts::dispatch_mode::leader_follower));
+
+TEST(TaskMetricsBatch, PostBatch)
+{
+    ssts::scheduler_options options;
+    options.pool.num_threads = 2;
+    options.per_task_metrics = true;
+    ssts::task_scheduler s(options);
+    s.start();
+
+    std::vector<ssts::batch_task> tasks;
+    for (auto n = 0; n < 5; ++n)
+        tasks.emplace_back(ssts::clock::now() + 1ms, []{ }, "batch"s, 1s);
+    s.post_batch(tasks.begin(), tasks.end());
+
+    std::this_thread::sleep_for(50ms);
+    const auto m = s.metrics("batch");
+    s.stop();
+
+    ASSERT_TRUE(m.has_value());
+    EXPECT_EQ(m->runs, 5u);
+}
+
+TEST(TaskMetricsDisabled, NothingIsRecorded)
+{
+    ssts::task_scheduler s(2);
+    s.start();
+    s.in("task_id"s, 1ms, []{ }).get();
+    s.stop();
+
+    EXPECT_FALSE(s.metrics("task_id").has_value());
+}
+
+}
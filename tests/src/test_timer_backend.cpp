@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+#include <ssts/task_scheduler.hpp>
+
+namespace ssts
+{
+
+TEST(TimerfdTimer, WaitUntil)
+{
+    if (!ssts::timerfd_timer::is_supported())
+        GTEST_SKIP() << "timerfd is not available on this platform";
+
+    ssts::timerfd_timer timer;
+    const auto timepoint = ssts::clock::now() + 5ms;
+    EXPECT_TRUE(timer.wait_until(timepoint));
+    EXPECT_GE(ssts::clock::now(), timepoint);
+
+    // Time points in the past expire immediately.
+    EXPECT_TRUE(timer.wait_until(ssts::clock::now() - 1s));
+}
+
+TEST(TimerfdTimer, Notify)
+{
+    if (!ssts::timerfd_timer::is_supported())
+        GTEST_SKIP() << "timerfd is not available on this platform";
+
+    ssts::timerfd_timer timer;
+
+    // A notification sent before waiting is not lost, and it is consumed by the wait.
+    timer.notify();
+    EXPECT_FALSE(timer.wait_until(ssts::clock::now() + 1h));
+
+    std::thread t([&timer]{ std::this_thread::sleep_for(10ms); timer.notify(); });
+    EXPECT_FALSE(timer.wait_until(ssts::clock::time_point::max()));
+    t.join();
+
+    // A stale expiration is discarded when the timer is re-armed.
+    EXPECT_TRUE(timer.wait_until(ssts::clock::now() + 1ms));
+}
+
+class TimerBackend : public ::testing::TestWithParam<ssts::timer_backend>
+{
+protected:
+    std::unique_ptr<ssts::task_scheduler> make_scheduler(ssts::wait_strategy wait = {})
+    {
+        ssts::scheduler_options options;
+        options.pool.num_threads = 2;
+        options.timer = GetParam();
+        options.wait = wait;
+        return std::make_unique<ssts::task_scheduler>(options);
+    }
+};
+
+TEST_P(TimerBackend, InEveryRemove)
+{
+    auto s = make_scheduler();
+    s->start();
+
+    std::atomic_uint in_count = 0;
+    std::atomic_uint every_count = 0;
+    s->in(1h, [&in_count]{ ++in_count; });
+    s->in(50ms, [&in_count]{ ++in_count; });
+    s->every("every_id"s, 20ms, [&every_count]{ ++every_count; });
+    s->in("removed_id"s, 30ms, [&in_count]{ ++in_count; });
+    EXPECT_TRUE(s->remove_task("removed_id"));
+
+    std::this_thread::sleep_for(300ms);
+    s->stop();
+
+    EXPECT_EQ(in_count, 1u);
+    EXPECT_GE(every_count, 10u);
+}
+
+TEST_P(TimerBackend, EarlierTaskWakesUpScheduler)
+{
+    auto s = make_scheduler(ssts::wait_strategy::spin_then_park(100us));
+    s->start();
+
+    std::atomic_uint count = 0;
+    s->post_in(1h, [&count]{ ++count; });
+    std::this_thread::sleep_for(10ms);
+
+    const auto start = ssts::clock::now();
+    std::promise<ssts::clock::time_point> run_time;
+    s->post_in(10ms, [&run_time]{ run_time.set_value(ssts::clock::now()); });
+
+    const auto elapsed = run_time.get_future().get() - start;
+    EXPECT_GE(elapsed, 10ms);
+    EXPECT_LT(elapsed, 500ms);
+    s->stop();
+}
+
+TEST_P(TimerBackend, StopWhileIdle)
+{
+    auto s = make_scheduler();
+    s->start();
+    std::this_thread::sleep_for(10ms);
+
+    const auto start = ssts::clock::now();
+    s->stop();
+    EXPECT_LT(ssts::clock::now() - start, 500ms);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, TimerBackend, ::testing::Values(ssts::timer_backend::condition_variable, ssts::timer_backend::timerfd));
+
+}
@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+#include <ssts/task_scheduler.hpp>
+
+namespace ssts
+{
+
+class TimerSlack : public ::testing::Test
+{
+protected:
+    void record(const std::string& name, const ssts::clock::time_point& timepoint)
+    {
+        std::scoped_lock lock(mtx);
+        run_time_points[name] = { timepoint, ssts::clock::now() };
+    }
+
+    std::pair<ssts::clock::time_point, ssts::clock::time_point> get(const std::string& name)
+    {
+        std::scoped_lock lock(mtx);
+        return run_time_points[name];
+    }
+
+    std::mutex mtx;
+    std::unordered_map<std::string, std::pair<ssts::clock::time_point, ssts::clock::time_point>> run_time_points;
+};
+
+TEST_F(TimerSlack, DeadlinesWithinSlackAreCoalesced)
+{
+    ssts::scheduler_options options;
+    options.pool.num_threads = 2;
+    options.timer_slack = 100ms;
+    ssts::task_scheduler s(options);
+    s.start();
+
+    const auto start = ssts::clock::now();
+    for (auto n = 1; n <= 4; ++n)
+    {
+        const auto timepoint = start + n * 10ms;
+        s.at(ssts::clock::time_point{ timepoint }, [this, n, timepoint]{ record(std::to_string(n), timepoint); });
+    }
+
+    std::this_thread::sleep_for(300ms);
+    s.stop();
+
+    // All the tasks start after their own time point and within the slack of the earliest one.
+    for (auto n = 1; n <= 4; ++n)
+    {
+        const auto [timepoint, run_timepoint] = get(std::to_string(n));
+        EXPECT_GE(run_timepoint, timepoint);
+        EXPECT_GE(run_timepoint, start + 110ms);
+    }
+
+    EXPECT_EQ(s.wakeups_saved(), 3u);
+}
+
+TEST_F(TimerSlack, PerTaskSlack)
+{
+    ssts::scheduler_options options;
+    options.pool.num_threads = 2;
+    options.timer_slack = 200ms;
+    ssts::task_scheduler s(options);
+    s.start();
+
+    // The task without slack caps the wake-up time point: the earlier task is dispatched with it.
+    const auto start = ssts::clock::now();
+    const auto early = start + 10ms;
+    const auto strict = start + 30ms;
+    s.at(ssts::clock::time_point{ early }, [this, early]{ record("early", early); });
+    s.at("strict"s, ssts::clock::time_point{ strict }, [this, strict]{ record("strict", strict); });
+    EXPECT_TRUE(s.set_slack("strict", 0ms));
+    EXPECT_FALSE(s.set_slack("missing", 0ms));
+
+    std::this_thread::sleep_for(150ms);
+    s.stop();
+
+    const auto [early_timepoint, early_run] = get("early");
+    const auto [strict_timepoint, strict_run] = get("strict");
+    EXPECT_GE(early_run, strict_timepoint);
+    EXPECT_GE(strict_run, strict_timepoint);
+    EXPECT_LT(strict_run, strict_timepoint + 100ms);
+    EXPECT_EQ(s.wakeups_saved(), 1u);
+}
+
+TEST_F(TimerSlack, PeriodicTasks)
+{
+    ssts::scheduler_options options;
+    options.pool.num_threads = 2;
+    options.timer_slack = 20ms;
+    ssts::task_scheduler s(options);
+    s.start();
+
+    // Two periodic tasks 1ms apart are dispatched by a single wake-up.
+    std::atomic_uint a_count = 0;
+    std::atomic_uint b_count = 0;
+    s.every(10ms, [&a_count]{ ++a_count; });
+    std::this_thread::sleep_for(1ms);
+    s.every(10ms, [&b_count]{ ++b_count; });
+
+    std::this_thread::sleep_for(200ms);
+    s.stop();
+
+    EXPECT_GE(a_count, 5u);
+    EXPECT_GE(b_count, 5u);
+    EXPECT_GE(s.wakeups_saved(), 5u);
+}
+
+TEST(TimerSlackDefault, NoWakeupsSaved)
+{
+    ssts::task_scheduler s(2);
+    s.start();
+
+    s.in(10ms, []{ });
+    s.in(20ms, []{ });
+    std::this_thread::sleep_for(100ms);
+    s.stop();
+
+    EXPECT_EQ(s.wakeups_saved(), 0u);
+}
+
+}
@@ -0,0 +1,122 @@
+#include "gtest/gtest.h"
+#include <ssts/task_scheduler.hpp>
+#include <sstream>
+
+namespace ssts
+{
+
+namespace
+{
+
+size_t count(const std::string& text, const std::string& pattern)
+{
+    size_t n = 0;
+    for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + pattern.size()))
+        ++n;
+
+    return n;
+}
+
+std::string chrome_trace()
+{
+    std::ostringstream os;
+    ssts::tracer::instance().write_chrome_trace(os);
+    return os.str();
+}
+
+}
+
+TEST(Trace, ChromeTraceFormat)
+{
+    auto& t = ssts::tracer::instance();
+    t.clear();
+
+    std::thread([&t]
+    {
+        t.set_thread_name("trace_test_thread");
+        t.record(ssts::trace_event::submit, 42);
+        t.record(ssts::trace_event::start, 42);
+        t.record(ssts::trace_event::end, 42);
+    }).join();
+
+    const auto trace = chrome_trace();
+    EXPECT_EQ(trace.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    EXPECT_EQ(count(trace, "\"name\":\"trace_test_thread\""), 1u);
+    EXPECT_EQ(count(trace, "\"name\":\"submit\",\"cat\":\"ssts\",\"ph\":\"i\""), 1u);
+    EXPECT_EQ(count(trace, "\"ph\":\"B\""), 1u);
+    EXPECT_EQ(count(trace, "\"ph\":\"E\""), 1u);
+    EXPECT_EQ(count(trace, "\"task\":\"42\""), 3u);
+    EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+}
+
+TEST(Trace, Clear)
+{
+    auto& t = ssts::tracer::instance();
+    t.record(ssts::trace_event::remove, 1);
+    t.clear();
+    t.record(ssts::trace_event::update, 1);
+
+    const auto trace = chrome_trace();
+    EXPECT_EQ(count(trace, "\"name\":\"remove\""), 0u);
+    EXPECT_EQ(count(trace, "\"name\":\"update\""), 1u);
+}
+
+TEST(Trace, ThreadNamesAreEscaped)
+{
+    auto& t = ssts::tracer::instance();
+    t.clear();
+
+    std::thread([&t] { t.set_thread_name("say \"hi\" \\ \n"); }).join();
+
+    const auto trace = chrome_trace();
+    EXPECT_EQ(count(trace, R"("name":"say \"hi\" \\ \u000a")"), 1u);
+    EXPECT_EQ(count(trace, "say \"hi\""), 0u);
+}
+
+TEST(Trace, RingBufferKeepsLatestEvents)
+{
+    auto& t = ssts::tracer::instance();
+    t.clear();
+
+    std::thread([&t]
+    {
+        for (size_t n = 0; n < SSTS_TRACE_BUFFER_CAPACITY + 10; ++n)
+            t.record(ssts::trace_event::expire, n);
+    }).join();
+
+    const auto trace = chrome_trace();
+    EXPECT_EQ(count(trace, "\"name\":\"expire\""), static_cast<size_t>(SSTS_TRACE_BUFFER_CAPACITY));
+    EXPECT_EQ(count(trace, "\"task\":\"9\""), 0u);
+    EXPECT_EQ(count(trace, "\"task\":\"10\""), 1u);
+}
+
+#if defined(SSTS_ENABLE_TRACING)
+TEST(Trace, TaskLifecycle)
+{
+    ssts::tracer::instance().clear();
+
+    ssts::pool_options options;
+    options.num_threads = 2;
+    ssts::task_scheduler s(options);
+    s.start();
+    s.every("task_id"s, 10ms, []{ });
+    std::this_thread::sleep_for(50ms);
+    s.update_interval("task_id"s, 20ms);
+    s.remove_task("task_id"s);
+    s.stop();
+
+    const auto trace = chrome_trace();
+    EXPECT_EQ(count(trace, "\"name\":\"ssts scheduler\""), 1u);
+    EXPECT_GE(count(trace, "\"name\":\"ssts worker "), 2u);
+    EXPECT_EQ(count(trace, "\"name\":\"submit\""), 1u);
+    EXPECT_EQ(count(trace, "\"name\":\"insert\""), 1u);
+    EXPECT_GE(count(trace, "\"name\":\"expire\""), 3u);
+    EXPECT_GE(count(trace, "\"name\":\"enqueue\""), 3u);
+    EXPECT_GE(count(trace, "\"ph\":\"B\""), 3u);
+    EXPECT_EQ(count(trace, "\"ph\":\"B\""), count(trace, "\"ph\":\"E\""));
+    EXPECT_EQ(count(trace, "\"name\":\"update\""), 1u);
+    EXPECT_EQ(count(trace, "\"name\":\"remove\""), 1u);
+}
+#endif
+
+}
@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+#include <ssts/task_scheduler.hpp>
+
+namespace ssts
+{
+
+TEST(WaitStrategy, ParkByDefault)
+{
+    EXPECT_FALSE(ssts::wait_strategy{}.is_spinning());
+    EXPECT_FALSE(ssts::wait_strategy::park().is_spinning());
+    EXPECT_TRUE(ssts::wait_strategy::spin_then_park(10us).is_spinning());
+    EXPECT_TRUE(ssts::wait_strategy::spin_then_park(0us, 10us).is_spinning());
+}
+
+TEST(WaitStrategy, SpinWait)
+{
+    const auto strategy = ssts::wait_strategy::spin_then_park(2ms, 2ms);
+
+    auto start = ssts::clock::now();
+    EXPECT_FALSE(ssts::spin_wait(strategy, []{ return false; }));
+    EXPECT_GE(ssts::clock::now() - start, 4ms);
+
+    std::atomic_bool is_ready = false;
+    std::thread t([&is_ready]{ std::this_thread::sleep_for(1ms); is_ready = true; });
+    EXPECT_TRUE(ssts::spin_wait(ssts::wait_strategy::spin_then_park(1s), [&is_ready]{ return is_ready.load(); }));
+    t.join();
+}
+
+TEST(WaitStrategy, SpinWaitUntil)
+{
+    const auto strategy = ssts::wait_strategy::spin_then_park(1ms, 5ms);
+
+    const auto timepoint = ssts::clock::now() + 5ms;
+    EXPECT_TRUE(ssts::spin_wait_until(strategy, timepoint, []{ return false; }));
+    EXPECT_GE(ssts::clock::now(), timepoint);
+
+    EXPECT_FALSE(ssts::spin_wait_until(strategy, ssts::clock::now() + 1s, []{ return true; }));
+}
+
+class SpinningPool : public ::testing::TestWithParam<ssts::pool_mode> { };
+
+TEST_P(SpinningPool, RunsTasks)
+{
+    ssts::pool_options options;
+    options.num_threads = 2;
+    options.mode = GetParam();
+    options.wait = ssts::wait_strategy::spin_then_park(50us, 50us);
+    ssts::task_pool tp(options);
+
+    // Tasks are pushed both while workers spin and after they are parked.
+    std::atomic_uint count = 0;
+    for (auto n = 0; n < 100; ++n)
+    {
+        tp.post([&count]{ ++count; });
+        if (n % 10 == 0)
+            std::this_thread::sleep_for(1ms);
+    }
+
+    EXPECT_EQ(tp.submit([]{ return 1; }).get(), 1);
+    tp.stop();
+    EXPECT_EQ(count, 100u);
+}
+
+INSTANTIATE_TEST_SUITE_P(Modes, SpinningPool, ::testing::Values(ssts::pool_mode::shared_queue, ssts::pool_mode::work_stealing));
+
+TEST(SpinningScheduler, RunsTasksOnTime)
+{
+    ssts::scheduler_options options;
+    options.pool.num_threads = 1;
+    options.pool.wait = ssts::wait_strategy::spin_then_park(50us);
+    options.wait = ssts::wait_strategy::spin_then_park(200us, 200us);
+    ssts::task_scheduler s(options);
+    s.start();
+
+    std::atomic_uint early_count = 0;
+    std::atomic_uint count = 0;
+    for (auto n = 1; n <= 20; ++n)
+    {
+        const auto timepoint = ssts::clock::now() + n * 1ms;
+        s.post_at(ssts::clock::time_point{ timepoint }, [&count, &early_count, timepoint]
+        {
+            if (ssts::clock::now() < timepoint)
+                ++early_count;
+            ++count;
+        });
+    }
+
+    // An earlier task submitted while the scheduler thread is busy waiting interrupts the wait.
+    std::atomic_bool is_run = false;
+    s.post_in(0ms, [&is_run]{ is_run = true; });
+
+    std::this_thread::sleep_for(100ms);
+    s.stop();
+
+    EXPECT_TRUE(is_run);
+    EXPECT_EQ(count, 20u);
+    EXPECT_EQ(early_count, 0u);
+}
+
+}
@@ -0,0 +1,115 @@
+#include "scheduler_fixture.hpp"
+#include <thread>
+#include <vector>
+#include <unordered_set>
+
+namespace ssts
+{
+
+TEST(WorkStealing, PostFromOutside)
+{
+    std::atomic_uint count = 0;
+    {
+        ssts::pool_options options;
+        options.num_threads = 4;
+        options.mode = ssts::pool_mode::work_stealing;
+        ssts::task_pool tp(options);
+        EXPECT_EQ(tp.mode(), ssts::pool_mode::work_stealing);
+
+        for (auto n = 0; n < 1000; ++n)
+            tp.post([&count]{ ++count; });
+
+        std::this_thread::sleep_for(500ms);
+        tp.stop();
+    }
+    EXPECT_EQ(count, 1000u);
+}
+
+TEST(WorkStealing, NestedTasksRunOnAllWorkers)
+{
+    // Each root task is pushed from outside the pool, then it pushes its children into the local deque of its worker:
+    // children of a blocked worker must be stolen by the others.
+    std::atomic_uint count = 0;
+    std::mutex ids_mtx;
+    std::unordered_set<std::thread::id> ids;
+    {
+        ssts::pool_options options;
+        options.num_threads = 4;
+        options.mode = ssts::pool_mode::work_stealing;
+        ssts::task_pool tp(options);
+        tp.post([&]
+        {
+            for (auto n = 0; n < 64; ++n)
+                tp.post([&]
+                {
+                    { std::scoped_lock lock(ids_mtx); ids.insert(std::this_thread::get_id()); }
+                    std::this_thread::sleep_for(5ms);
+                    ++count;
+                });
+
+            std::this_thread::sleep_for(200ms);
+        });
+
+        std::this_thread::sleep_for(1s);
+        tp.stop();
+    }
+    EXPECT_EQ(count, 64u);
+    EXPECT_GT(ids.size(), 1u);
+}
+
+TEST(WorkStealing, SubmitThen)
+{
+    ssts::pool_options options;
+    options.num_threads = 2;
+    options.mode = ssts::pool_mode::work_stealing;
+    ssts::task_pool tp(options);
+    auto f = tp.submit([]{ return 20; }).then([](int x){ return x + 1; }).then([](int x){ return x * 2; });
+    EXPECT_EQ(f.get(), 42);
+    tp.stop();
+}
+
+TEST(WorkStealing, ConcurrentProducers)
+{
+    constexpr unsigned n_producers = 4;
+    constexpr unsigned n_tasks_per_producer = 1'000;
+    std::atomic_uint count = 0;
+    {
+        ssts::pool_options options;
+        options.num_threads = 4;
+        options.mode = ssts::pool_mode::work_stealing;
+        ssts::task_pool tp(options);
+        std::vector<std::thread> producers;
+        for (unsigned p = 0; p < n_producers; ++p)
+            producers.emplace_back([&tp, &count] 
+            { 
+                for (unsigned n = 0; n < n_tasks_per_producer; ++n) 
+                    tp.post([&count]{ ++count; }); 
+            });
+
+        for (auto& t : producers)
+            t.join();
+
+        std::this_thread::sleep_for(500ms);
+        tp.stop();
+    }
+    EXPECT_EQ(count, n_producers * n_tasks_per_producer);
+}
+
+TEST(WorkStealing, Scheduler)
+{
+    std::atomic_uint count = 0;
+    ssts::pool_options options;
+    options.num_threads = 2;
+    options.mode = ssts::pool_mode::work_stealing;
+    ssts::task_scheduler s(options);
+    s.start();
+
+    s.every("task_id"s, 10ms, [&count]{ ++count; });
+    s.post_in(50ms, [&count]{ count += 100; });
+    std::this_thread::sleep_for(300ms);
+    s.stop();
+
+    EXPECT_GE(count, 110u);
+}
+
+}